@@ -73,7 +73,7 @@
  #include "CTS_Layer.h"
 
 //unsigned int position;
-unsigned int dCnt[4];
+cts_count_t dCnt[4];
 
 // Main Function
 void main(void)
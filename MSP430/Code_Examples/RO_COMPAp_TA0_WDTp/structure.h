@@ -107,6 +107,7 @@ extern const struct Sensor slider;
 //#define fRO_PINOSC_TA1_TB0		33
 //#define fRO_CSIO_TA0_SW           34
 //#define fRO_CSIO_TA0_TA1          35
+//#define fRO_PINOSC_TA0_TA1CAP     36
 
 //****** WHEEL and SLIDER ******************************************************
 // Are wheel or slider representations used?
@@ -114,6 +115,100 @@ extern const struct Sensor slider;
 #define ILLEGAL_SLIDER_WHEEL_POSITION		0xFFFF
 //#define WHEEL
 
+//****** MATRIX ****************************************************************
+// Are row/column matrix keypads used?  A keypad is described by one sensor of
+// row electrodes and one sensor of column electrodes, TI_CAPT_Matrix() returns
+// the key at the intersection.
+//#define MATRIX
+#define ILLEGAL_MATRIX_KEY                  0xFFFF
+
+//****** TOUCHPAD **************************************************************
+// Are touchpads used?  A touchpad is described by one sensor of X electrodes
+// and one sensor of Y electrodes, each with points and sensorThreshold like a
+// slider.  TI_CAPT_Touchpad() returns the X/Y position and the touch size.
+//#define TOUCHPAD
+
+//****** POSITION TRACKING *****************************************************
+// Smooth slider and wheel positions with a fixed-point alpha-beta filter, see
+// TI_CAPT_Tracked_Slider() and TI_CAPT_Tracked_Wheel().  The gains are in
+// 1/256, TRACKING_LEAD is the number of scans the output is predicted ahead to
+// compensate the lag of the filter.
+//#define POSITION_TRACKING
+#define TRACKING_ALPHA                      128
+#define TRACKING_BETA                       32
+#define TRACKING_LEAD                       1
+
+//****** SLIDER LUT ************************************************************
+// Linearize slider and wheel positions with a per-sensor correction table of
+// points+1 entries in RAM, referenced by positionLut of the sensor and filled
+// by TI_CAPT_Calibrate_Position_Lut() or, for a wheel,
+// TI_CAPT_Calibrate_Wheel_Lut() from a calibration sweep.
+//#define SLIDER_LUT
+
+//****** ROI SCAN **************************************************************
+// While a touch is tracked by TI_CAPT_Roi_Buttons(), TI_CAPT_Roi_Slider() or
+// TI_CAPT_Roi_Wheel() only the ROI_RADIUS elements on each side of the last
+// dominant element are measured.  Every ROI_FULL_SCAN_INTERVAL+1 scans all
+// elements are measured to refresh the baselines and to catch new touches.
+//#define ROI_SCAN
+#define ROI_RADIUS                          1
+#define ROI_FULL_SCAN_INTERVAL              8
+
+//****** SENSOR CALLBACKS ******************************************************
+// Call application functions on press, release and position changes of
+// buttons, sliders and wheels from TI_CAPT_Buttons(), TI_CAPT_Slider() and
+// TI_CAPT_Wheel(), see TI_CAPT_Register_Callbacks().  CALLBACK_SENSORS is the
+// number of sensors that can be registered.
+//#define SENSOR_CALLBACKS
+#define CALLBACK_SENSORS                    4
+
+//****** STUCK TOUCH RECOVERY **************************************************
+// Re-baseline an element that stays above its threshold for STUCK_TOUCH_SCANS
+// consecutive scans (an object resting on the electrode or a corrupted
+// baseline) over its next RECOVERY_SCANS scans, without blocking and without
+// affecting the other elements.  See also TI_CAPT_Recover_Baseline().
+//#define STUCK_TOUCH_RECOVERY
+#define STUCK_TOUCH_SCANS                   1000
+#define RECOVERY_SCANS                      4
+
+//****** ELEMENT HYSTERESIS ****************************************************
+// Give elements a releaseThreshold, below threshold: a touch starts when the
+// delta reaches threshold and ends when it falls below releaseThreshold, so a
+// touch near the threshold does not toggle on consecutive scans.  Elements
+// with a releaseThreshold of 0 use threshold for both.
+//#define ELEMENT_HYSTERESIS
+
+//****** EXTENDED COUNTS *******************************************************
+// Extend measurement counts to 32 bits with the overflow interrupt of the
+// measurement timer instead of discarding measurements that exceed 16 bits.
+// This allows longer gate times (proximity sensing) with the WDT and RTC gated
+// RO methods, at the cost of 32-bit baseline RAM.  The TIMERx_A1 vector of the
+// measurement timer is then owned by the library.
+//#define EXTENDED_COUNTS
+
+//****** ELEMENT GATE **********************************************************
+// Allow each element to override the accumulationCycles (gate) of its sensor
+// so that large and small electrodes within one group are each measured with
+// the gate they need.  An element accumulationCycles of 0 uses the sensor
+// setting; with WDT gates the longest interval (select value 0) can therefore
+// only be chosen per sensor.
+//#define ELEMENT_GATE
+
+//****** COMPACT ELEMENT *******************************************************
+// Describe PinOsc and RC element pins with a port number and bit, for example
+// .inputPort = 1, .inputBits = BIT4 for P1.4, instead of three to five port
+// register addresses.  This reduces a PinOsc element from 10 to 6 bytes and an
+// RC element from 18 to 8 bytes.  Only available with PinOsc and RC methods.
+//#define COMPACT_ELEMENT
+
+//****** FLEXIBLE ELEMENT ARRAY ************************************************
+// Let arrayPtr of each sensor point to an array of exactly numElements element
+// pointers instead of reserving MAXIMUM_NUMBER_OF_ELEMENTS_PER_SENSOR pointers
+// within every sensor.  The array is defined in structure.c, for example:
+//    const struct Element *const wheelElements[] = {&e0, &e1, &e2, &e3};
+//    const struct Sensor wheel = { ... .arrayPtr = wheelElements, ... };
+//#define FLEXIBLE_ELEMENT_ARRAY
+
 //******************************************************************************
 // End of user configuration section.
 //******************************************************************************
@@ -216,6 +311,9 @@ extern const struct Sensor slider;
     #ifdef __MSP430G2452
       #define SEL2REGISTER
     #endif 
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by RO_COMPAp_TA0_WDTp"
+    #endif
 #endif
 
 #ifdef RO_PINOSC_TA0_WDTp
@@ -223,6 +321,9 @@ extern const struct Sensor slider;
     #define RO_PINOSC_TYPE
     #define WDT_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #define TIMER0A1_OVERFLOW
+    #endif
 #endif
 
 #ifdef RO_PINOSC_TA0
@@ -230,6 +331,9 @@ extern const struct Sensor slider;
     #define RO_PINOSC_TYPE
     #define TIMER_SCALE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by RO_PINOSC_TA0"
+    #endif
 #endif
 
 #ifdef RO_COMPAp_TA1_WDTp
@@ -237,6 +341,9 @@ extern const struct Sensor slider;
     #define RO_COMPAp_TYPE
     #define WDT_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by RO_COMPAp_TA1_WDTp"
+    #endif
 #endif
 
 #ifdef RO_COMPB_TA0_WDTA
@@ -244,6 +351,9 @@ extern const struct Sensor slider;
     #define RO_COMPB_TYPE
     #define WDT_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by RO_COMPB_TA0_WDTA"
+    #endif
 #endif
 
 #ifdef RO_COMPB_TA1_WDTA
@@ -251,6 +361,9 @@ extern const struct Sensor slider;
     #define RO_COMPB_TYPE
     #define WDT_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by RO_COMPB_TA1_WDTA"
+    #endif
 #endif
 
 #ifdef RO_COMPB_TB0_WDTA
@@ -258,6 +371,9 @@ extern const struct Sensor slider;
     #define RO_COMPB_TYPE
     #define WDT_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by RO_COMPB_TB0_WDTA"
+    #endif
 #endif
 
 #ifdef RC_PAIR_TA0
@@ -265,6 +381,9 @@ extern const struct Sensor slider;
     #define RC_PAIR_TYPE
     #define TIMER_SCALE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by RC_PAIR_TA0"
+    #endif
 #endif
 
 #ifdef fRO_PINOSC_TA0_SW
@@ -272,6 +391,9 @@ extern const struct Sensor slider;
     #define RO_PINOSC_TYPE
     #define TIMER_SCALE
 	#define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by fRO_PINOSC_TA0_SW"
+    #endif
 #endif
 
 #ifdef fRO_COMPB_TA0_SW
@@ -279,6 +401,9 @@ extern const struct Sensor slider;
     #define RO_COMPB_TYPE
     #define TIMER_SCALE
 	#define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by fRO_COMPB_TA0_SW"
+    #endif
 #endif
 
 #ifdef fRO_COMPB_TA1_SW
@@ -286,6 +411,9 @@ extern const struct Sensor slider;
     #define RO_COMPB_TYPE
     #define TIMER_SCALE
 	#define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by fRO_COMPB_TA1_SW"
+    #endif
 #endif
 
 #ifdef fRO_COMPAp_TA0_SW
@@ -293,6 +421,9 @@ extern const struct Sensor slider;
     #define RO_COMPAp_TYPE
     #define TIMER_SCALE
 	#define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by fRO_COMPAp_TA0_SW"
+    #endif
 #endif
 
 #ifdef fRO_COMPAp_TA1_SW
@@ -300,6 +431,9 @@ extern const struct Sensor slider;
     #define RO_COMPAp_TYPE
     #define TIMER_SCALE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by fRO_COMPAp_TA1_SW"
+    #endif
 #endif
 
 #ifdef fRO_COMPAp_SW_TA0
@@ -307,6 +441,9 @@ extern const struct Sensor slider;
     #define RO_COMPAp_TYPE
 	#define TIMER_SCALE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by fRO_COMPAp_SW_TA0"
+    #endif
 #endif
 
 #ifdef RO_COMPB_TA1_TA0
@@ -315,6 +452,9 @@ extern const struct Sensor slider;
     #define TIMER_SCALE
     #define TIMER0A0_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by RO_COMPB_TA1_TA0"
+    #endif
 #endif
 
 #ifdef fRO_COMPB_TA1_TA0
@@ -323,6 +463,9 @@ extern const struct Sensor slider;
     #define TIMER_SCALE
     #define TIMER1A0_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by fRO_COMPB_TA1_TA0"
+    #endif
 #endif
 
 #ifdef RO_PINOSC_TA0_TA1
@@ -331,6 +474,9 @@ extern const struct Sensor slider;
     #define TIMER_SCALE
     #define TIMER1A0_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by RO_PINOSC_TA0_TA1"
+    #endif
 #endif
 
 #ifdef fRO_PINOSC_TA0_TA1
@@ -339,6 +485,20 @@ extern const struct Sensor slider;
     #define TIMER_SCALE
     #define TIMER0A0_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by fRO_PINOSC_TA0_TA1"
+    #endif
+#endif
+
+#ifdef fRO_PINOSC_TA0_TA1CAP
+    #define RO_TYPE
+    #define RO_PINOSC_TYPE
+    #define TIMER_SCALE
+    #define TIMER0A0_CAPTURE
+    #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by fRO_PINOSC_TA0_TA1CAP"
+    #endif
 #endif
 
 #ifdef RO_CSIO_TA2_WDTA
@@ -346,6 +506,9 @@ extern const struct Sensor slider;
     #define RO_CSIO_TYPE
     #define WDT_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #define TIMER2A1_OVERFLOW
+    #endif
 #endif
 
 #ifdef RO_CSIO_TA2_TA3
@@ -354,6 +517,9 @@ extern const struct Sensor slider;
     #define TIMER_SCALE
     #define TIMER3A0_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by RO_CSIO_TA2_TA3"
+    #endif
 #endif
 
 #ifdef fRO_CSIO_TA2_TA3
@@ -362,6 +528,9 @@ extern const struct Sensor slider;
     #define TIMER_SCALE
     #define TIMER2A0_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by fRO_CSIO_TA2_TA3"
+    #endif
 #endif
 
 #ifdef RO_PINOSC_TA1_WDTp
@@ -369,6 +538,9 @@ extern const struct Sensor slider;
     #define RO_PINOSC_TYPE
     #define WDT_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #define TIMER1A1_OVERFLOW
+    #endif
 #endif
 
 #ifdef RO_PINOSC_TA1_TB0
@@ -377,6 +549,9 @@ extern const struct Sensor slider;
     #define TIMER_SCALE
     #define TIMERB0_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by RO_PINOSC_TA1_TB0"
+    #endif
 #endif
 
 #ifdef fRO_PINOSC_TA1_TA0
@@ -385,6 +560,9 @@ extern const struct Sensor slider;
     #define TIMER_SCALE
     #define TIMER1A0_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by fRO_PINOSC_TA1_TA0"
+    #endif
 #endif
 
 #ifdef fRO_PINOSC_TA1_TB0
@@ -393,6 +571,9 @@ extern const struct Sensor slider;
 	#define TIMER_SCALE
 	#define TIMER1A0_GATE
 	#define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by fRO_PINOSC_TA1_TB0"
+    #endif
 #endif
 
 #ifdef RO_CSIO_TA0_WDTA
@@ -400,6 +581,9 @@ extern const struct Sensor slider;
     #define RO_CSIO_TYPE
     #define WDT_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #define TIMER0A1_OVERFLOW
+    #endif
 #endif
 
 #ifdef RO_CSIO_TA0_TA1
@@ -408,6 +592,9 @@ extern const struct Sensor slider;
     #define TIMER_SCALE
     #define TIMER1A0_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by RO_CSIO_TA0_TA1"
+    #endif
 #endif
 
 #ifdef fRO_CSIO_TA0_TA1
@@ -416,6 +603,9 @@ extern const struct Sensor slider;
     #define TIMER_SCALE
     #define TIMER0A0_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by fRO_CSIO_TA0_TA1"
+    #endif
 #endif
 
 #ifdef fRO_CSIO_TA0_SW
@@ -423,6 +613,9 @@ extern const struct Sensor slider;
     #define RO_CSIO_TYPE
     #define TIMER_SCALE
 	#define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #error "EXTENDED_COUNTS is not supported by fRO_CSIO_TA0_SW"
+    #endif
 #endif
 
 #ifdef RO_CSIO_TA0_RTC
@@ -431,6 +624,9 @@ extern const struct Sensor slider;
     #define TIMER_SCALE
     #define RTC_GATE
 	#define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #define TIMER0A1_OVERFLOW
+    #endif
 #endif
 
 
@@ -443,15 +639,44 @@ extern const struct Sensor slider;
 	#define SLIDER_WHEEL
 #endif
 
+#ifdef TOUCHPAD
+	#define SLIDER_WHEEL
+#endif
+
+#if defined(COMPACT_ELEMENT) && (defined(RO_COMPAp_TYPE) \
+    || defined(RO_COMPB_TYPE) || defined(RO_CSIO_TYPE))
+#error "COMPACT_ELEMENT is only supported by the PinOsc and RC methods"
+#endif
+
 #define RO_MASK         0xC0        // 1100 0000
 #define RC_FRO_MASK     0x3F        // 0011 1111
 
+/*
+ *  Measurement count width.  With EXTENDED_COUNTS the overflow interrupt of
+ *  the measurement timer provides the upper 16 bits of each count.
+ */
+#ifdef EXTENDED_COUNTS
+typedef uint32_t cts_count_t;
+#else
+typedef uint16_t cts_count_t;
+#endif
+
 /*
  *  The element structure identifies port or comparator input definitions for
  *  each element.
  */
 struct Element{
 
+#ifdef COMPACT_ELEMENT
+// PinOsc+RC: port number (1: P1, 2: P2, 3: P3) and bit of the element, the
+// port register addresses are looked up by the HAL
+  uint8_t inputPort;               // PinOsc+RC: port number
+  uint8_t inputBits;               // PinOsc+RC: port bit definition
+#ifdef RC_PAIR_TYPE
+  uint8_t referencePort;           // RC: port number
+  uint8_t referenceBits;           // RC: port bit definition
+#endif
+#else
 #ifdef RO_PINOSC_TYPE
 // These register address definitions are needed for each sensor only
 // when using the PinOsc method
@@ -474,9 +699,19 @@ struct Element{
                                       //
                                       // for comparator input bit 
                                       // location in CACTL2 or CBCTL0
-                                      
+#endif
+
   uint16_t threshold;                   // specific threshold for each button
   uint16_t maxResponse;                 // Special Case: Slider max counts
+
+#ifdef ELEMENT_GATE
+  uint16_t accumulationCycles;          // gate override for this element,
+                                        // 0: use the sensor setting
+#endif
+#ifdef ELEMENT_HYSTERESIS
+  uint16_t releaseThreshold;            // end of touch, below threshold,
+                                        // 0: use threshold
+#endif
 };
 
 /*
@@ -498,12 +733,17 @@ struct Sensor{
   uint16_t *inputCapsioctlRegister;
 #endif
 
-  uint8_t numElements;             // number of elements within group
-  uint8_t baseOffset;              // the offset within the global 
+  uint16_t numElements;            // number of elements within group
+  uint16_t baseOffset;             // the offset within the global 
                                    // base_cnt array
 
+#ifdef FLEXIBLE_ELEMENT_ARRAY
+  struct Element const * const *arrayPtr;
+                                   // an array of numElements pointers
+#else
   struct Element const *arrayPtr[MAXIMUM_NUMBER_OF_ELEMENTS_PER_SENSOR];    
                                    // an array of pointers
+#endif
 
 //******************************************************************************
 // Reference structure definitions for comparator types, for the RC method the 
@@ -585,6 +825,10 @@ struct Sensor{
   uint8_t points;                   // Special Case: Number of points
                                     // along slider or wheel  
   uint8_t sensorThreshold;
+#ifdef SLIDER_LUT
+  uint8_t *positionLut;             // corrected position for each raw
+                                    // position 0 to points, 0: no correction
+#endif
 #endif                               
 
 };
@@ -71,7 +71,7 @@
 
 #define NUM_SEN	12
 
-uint16_t dCnt[NUM_SEN];
+cts_count_t dCnt[NUM_SEN];
 struct Element* keypressed;
 
 const struct Element* address_list[NUM_SEN] = 
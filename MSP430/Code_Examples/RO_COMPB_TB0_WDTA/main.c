@@ -70,7 +70,7 @@
 #define LED7		BIT3
 #define LED8		BIT1
 
-uint16_t dCnt[NUM_KEYS];
+cts_count_t dCnt[NUM_KEYS];
 struct Element* keypressed;
 
 const struct Element* address_list[NUM_KEYS] =
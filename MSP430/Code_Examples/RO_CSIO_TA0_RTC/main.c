@@ -70,7 +70,7 @@
 
 #ifdef ELEMENT_CHARACTERIZATION_MODE
 // Delta Counts returned from the API function for the sensor during characterization
-unsigned int dCnt[5];
+cts_count_t dCnt[5];
 #endif
 
 unsigned char tempflag;
@@ -68,7 +68,7 @@
 
 #ifdef ELEMENT_CHARACTERIZATION_MODE
 // Delta Counts returned from the API function for the sensor during characterization
-unsigned int dCnt[5];
+cts_count_t dCnt[5];
 #endif
 
 unsigned char tempflag;
@@ -121,7 +121,7 @@ void main(void)
   	
   	#ifdef ELEMENT_CHARACTERIZATION_MODE
 	// Get the raw delta counts for element characterization 
-	TI_CAPT_Custom(&one_button,&dCnt);
+	TI_CAPT_Custom(&one_button,dCnt);
 	__no_operation(); 					// Set breakpoint here	
 	#endif
 	  	
@@ -88,7 +88,7 @@
 #define PROXIMITY_THRESHOLD     130				//
 
 unsigned int wheel_position=ILLEGAL_SLIDER_WHEEL_POSITION, last_wheel_position=ILLEGAL_SLIDER_WHEEL_POSITION;
-unsigned int deltaCnts[1];
+cts_count_t deltaCnts[1];
 unsigned int prox_raw_Cnts;
 
 /*----------------- LED definition---------------------------------------------
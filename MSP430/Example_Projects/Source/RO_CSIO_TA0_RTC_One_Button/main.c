@@ -74,7 +74,7 @@
 
 #ifdef ELEMENT_CHARACTERIZATION_MODE
 // Delta Counts returned from the API function for the sensor during characterization
-unsigned int dCnt;
+cts_count_t dCnt;
 #endif
 
 unsigned char tempflag;
@@ -69,9 +69,9 @@
 
 #ifdef ELEMENT_CHARACTERIZATION_MODE
 // Delta Counts returned from the API function for the sensor during characterization
-unsigned int dCnt;
+cts_count_t dCnt;
 #endif
-unsigned int dCnt;
+cts_count_t dCnt;
 unsigned char tempflag;
 
 // Sleep Function
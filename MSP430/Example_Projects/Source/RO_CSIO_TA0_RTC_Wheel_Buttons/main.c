@@ -74,12 +74,28 @@
 
 #ifdef ELEMENT_CHARACTERIZATION_MODE
 // Delta Counts returned from the API function for the sensor during characterization
-unsigned int dCnt[5];
+cts_count_t dCnt[5];
 #endif
 
 unsigned char tempflag;
 
-struct Element * keyPressed;
+#ifndef ELEMENT_CHARACTERIZATION_MODE
+// Called by TI_CAPT_Buttons() when one of the five buttons is touched
+// and when the touch is released; a touch moving to another button is
+// the release of the old and the press of the new button
+void buttonPress(const struct Sensor *buttons, uint16_t element)
+{
+    P8OUT |= BIT1;                      // Turn on center LED
+}
+
+void buttonRelease(const struct Sensor *buttons, uint16_t element)
+{
+    P8OUT &= ~BIT1;                     // Turn off center LED
+}
+
+struct SensorCallbacks buttonCallbacks = { buttonPress, buttonRelease };
+#endif
+
 // Sleep Function
 // Configures Timer A to run off ACLK, count in UP mode, places the CPU in LPM3 
 // and enables the interrupt vector to jump to ISR upon timeout 
@@ -119,6 +135,11 @@ void main(void)
   
   // Update baseline measurement (Average 100 measurements)
   TI_CAPT_Update_Baseline(&wheel_buttons,100);
+
+  #ifndef ELEMENT_CHARACTERIZATION_MODE
+  // Have TI_CAPT_Buttons() call buttonPress and buttonRelease
+  TI_CAPT_Register_Callbacks(&wheel_buttons, &buttonCallbacks);
+  #endif
   
   // Main loop starts here
   while (1)
@@ -131,45 +152,8 @@ void main(void)
 	#endif
 	  	
 	#ifndef ELEMENT_CHARACTERIZATION_MODE	  	
-	// Check if the middle element sensor has been triggered. The API call
-	// compares the value from the sensor against the threshold to determine
-	// trigger condition
-
-	keyPressed = (struct Element *)TI_CAPT_Buttons(&wheel_buttons);
-
-		// If a button has been touched, then take some action
-    if(keyPressed)
-	{
-			// Up Element P2.4
-	  if(keyPressed == &up_element)
-		{
-			P8OUT |= BIT1;                            // Turn on center LED
-		}
-			// Down Element P3.6
-	  if(keyPressed == &down_element)
-		{
-			P8OUT |= BIT1;                            // Turn on center LED
-		}
-			// Left Element P3.5
-	  if(keyPressed == &left_element)
-		{
-			P8OUT |= BIT1;                            // Turn on center LED
-		}
-			// Right Element P1.3
-	  if(keyPressed == &right_element)
-		{
-			P8OUT |= BIT1;                            // Turn on center LED
-		}
-			// Middle Element P1.5
-	  if(keyPressed == &middle_element)
-		{
-			P8OUT |= BIT1;                            // Turn on center LED
-		}
-	}
-	else
-	{
-	   P8OUT &= ~BIT1;                           // Turn off center LED
-	}
+	// Scan the buttons: the callbacks are called when the touch changes
+	TI_CAPT_Buttons(&wheel_buttons);
     // Put the MSP430 into LPM3 for a certain DELAY period
     sleep(DELAY);
     #endif
@@ -71,7 +71,7 @@
 
 #ifdef ELEMENT_CHARACTERIZATION_MODE
 // Delta Counts returned from the API function for the sensor during characterization
-unsigned int dCnt;
+cts_count_t dCnt;
 #endif
 
 // Sleep Function
@@ -72,9 +72,9 @@
 #define KEY_lvl     150              // Defines the min count for a "key press"
                                      // Set to ~ half the max delta expected
 // Global variables for sensing
-unsigned int base_cnt;
-unsigned int meas_cnt;
-unsigned int delta_cnt;
+cts_count_t base_cnt;
+cts_count_t meas_cnt;
+cts_count_t delta_cnt;
 
 char key_pressed, key_loc;
 int cycles;
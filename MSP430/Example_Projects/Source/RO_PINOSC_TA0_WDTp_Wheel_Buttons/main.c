@@ -63,11 +63,26 @@
 
 #define DELAY 5000 		// Timer delay timeout count, 5000*0.1msec = 500 msec
 
-struct Element * keyPressed;			// Pointer to the Element structure
-
 #ifdef ELEMENT_CHARACTERIZATION_MODE
 // Delta Counts returned from the API function for the sensor during characterization
-unsigned int wheelCnt[5];				// Becuase the Wheel is composed of five elements
+cts_count_t wheelCnt[5];				// Becuase the Wheel is composed of five elements
+#endif
+
+#ifndef ELEMENT_CHARACTERIZATION_MODE
+// Called by TI_CAPT_Buttons() when one of the five buttons is touched
+// and when the touch is released; a touch moving to another button is
+// the release of the old and the press of the new button
+void buttonPress(const struct Sensor *buttons, uint16_t element)
+{
+    P1OUT |= BIT0;                      // Turn on center LED
+}
+
+void buttonRelease(const struct Sensor *buttons, uint16_t element)
+{
+    P1OUT &= ~(BIT0);                   // Turn off center LED
+}
+
+struct SensorCallbacks buttonCallbacks = { buttonPress, buttonRelease };
 #endif
 
 // Sleep Function
@@ -106,6 +121,11 @@ void main(void)
   // Update baseline measurement (Average 5 measurements)
   TI_CAPT_Update_Baseline(&wheel_buttons,5);  
 
+  #ifndef ELEMENT_CHARACTERIZATION_MODE
+  // Have TI_CAPT_Buttons() call buttonPress and buttonRelease
+  TI_CAPT_Register_Callbacks(&wheel_buttons, &buttonCallbacks);
+  #endif
+
   // Main loop starts here
   while (1)
   {
@@ -118,42 +138,8 @@ void main(void)
 	
 	
 	#ifndef ELEMENT_CHARACTERIZATION_MODE
-	// Return the pointer to the element which has been touched
-	keyPressed = (struct Element *)TI_CAPT_Buttons(&wheel_buttons);
-	
-	// If a button has been touched, then take some action
-	if(keyPressed)
-	{
-		// Up Element
-		if(keyPressed == &up_element)
-		{
-			P1OUT |= BIT0;				// Turn on center LED
-		}
-		// Down Element
-		if(keyPressed == &down_element)
-		{
-			P1OUT |= BIT0;				// Turn on center LED
-		}
-		// Left Element
-		if(keyPressed == &left_element)
-		{
-			P1OUT |= BIT0;				// Turn on center LED
-		}
-		// Right Element
-		if(keyPressed == &right_element)
-		{
-			P1OUT |= BIT0;				// Turn on center LED
-		}						
-		// Middle Element
-		if(keyPressed == &middle_element)
-		{
-			P1OUT |= BIT0;				// Turn on center LED
-		}
-	  }
-	  else
-	  {
-	      P1OUT &= ~(BIT0);				// Turn off center LED
-	  }      
+	// Scan the buttons: the callbacks are called when the touch changes
+	TI_CAPT_Buttons(&wheel_buttons);
         
     // Put the MSP430 into LPM3 for a certain DELAY period
     sleep(DELAY);
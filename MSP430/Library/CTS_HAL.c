@@ -91,6 +91,80 @@
 
 #include "CTS_HAL.h"
 
+#if defined(TIMER0A1_OVERFLOW) || defined(TIMER1A1_OVERFLOW) \
+    || defined(TIMER2A1_OVERFLOW)
+/*!
+ *  Upper 16 bits of the measurement in progress, incremented by the
+ *  measurement timer overflow ISR when EXTENDED_COUNTS is defined.
+ */
+static volatile uint16_t ctsOverflowCount;
+#endif
+
+/*
+ *  Gate (accumulationCycles) used for element i of a sensor.  With
+ *  ELEMENT_GATE a non-zero accumulationCycles in the element overrides the
+ *  setting of the sensor.
+ */
+#ifdef ELEMENT_GATE
+#define ACCUMULATION_CYCLES(group, i)                                         \
+    (((group)->arrayPtr[i])->accumulationCycles                               \
+        ? ((group)->arrayPtr[i])->accumulationCycles                          \
+        : (group)->accumulationCycles)
+#else
+#define ACCUMULATION_CYCLES(group, i)  ((group)->accumulationCycles)
+#endif
+
+/*
+ *  Port registers of element e.  With COMPACT_ELEMENT the element holds a
+ *  port number (1: P1, 2: P2, 3: P3) that indexes the tables below.
+ */
+#ifdef COMPACT_ELEMENT
+#ifdef RO_PINOSC_TYPE
+static volatile uint8_t * const ctsPxsel[] = {&P1SEL, &P2SEL
+#ifdef __MSP430_HAS_PORT3_R__
+    , &P3SEL
+#endif
+};
+static volatile uint8_t * const ctsPxsel2[] = {&P1SEL2, &P2SEL2
+#ifdef __MSP430_HAS_PORT3_R__
+    , &P3SEL2
+#endif
+};
+#define ELEMENT_PXSEL(e)      (ctsPxsel[(e)->inputPort - 1])
+#define ELEMENT_PXSEL2(e)     (ctsPxsel2[(e)->inputPort - 1])
+#endif
+#ifdef RC_PAIR_TYPE
+static volatile uint8_t * const ctsPxout[] = {&P1OUT, &P2OUT
+#if defined(__MSP430_HAS_PORT3_R__) || defined(__MSP430_HAS_PORT3__)
+    , &P3OUT
+#endif
+};
+static volatile uint8_t * const ctsPxin[] = {&P1IN, &P2IN
+#if defined(__MSP430_HAS_PORT3_R__) || defined(__MSP430_HAS_PORT3__)
+    , &P3IN
+#endif
+};
+static volatile uint8_t * const ctsPxdir[] = {&P1DIR, &P2DIR
+#if defined(__MSP430_HAS_PORT3_R__) || defined(__MSP430_HAS_PORT3__)
+    , &P3DIR
+#endif
+};
+#define ELEMENT_PXOUT(e)      (ctsPxout[(e)->inputPort - 1])
+#define ELEMENT_PXIN(e)       (ctsPxin[(e)->inputPort - 1])
+#define ELEMENT_PXDIR(e)      (ctsPxdir[(e)->inputPort - 1])
+#define ELEMENT_REF_PXOUT(e)  (ctsPxout[(e)->referencePort - 1])
+#define ELEMENT_REF_PXDIR(e)  (ctsPxdir[(e)->referencePort - 1])
+#endif
+#else
+#define ELEMENT_PXSEL(e)      ((e)->inputPxselRegister)
+#define ELEMENT_PXSEL2(e)     ((e)->inputPxsel2Register)
+#define ELEMENT_PXOUT(e)      ((e)->inputPxoutRegister)
+#define ELEMENT_PXIN(e)       ((e)->inputPxinRegister)
+#define ELEMENT_PXDIR(e)      ((e)->inputPxdirRegister)
+#define ELEMENT_REF_PXOUT(e)  ((e)->referencePxoutRegister)
+#define ELEMENT_REF_PXDIR(e)  ((e)->referencePxdirRegister)
+#endif
+
 #ifdef RO_COMPB_TB0_WDTA
 /*!
  *  ======== TI_CTS_RO_COMPB_TB0_WDTA_HAL ========
@@ -112,9 +186,9 @@
  *  @param counts pointer to where the measurements are to be written
  *  @return none
  */
-void TI_CTS_RO_COMPB_TB0_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_RO_COMPB_TB0_WDTA_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-   uint8_t i;
+   uint16_t i;
    /*
     *  Allocate Context Save Variables
     *  Status Register: GIE bit only
@@ -194,7 +268,7 @@ void TI_CTS_RO_COMPB_TB0_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
          *  accumulationCycles represents the watchdog timer interval select.
          */
         WDTCTL = WDTPW+WDTTMSEL+WDTCNTCL+ group->measGateSource
-                + group->accumulationCycles;
+                + ACCUMULATION_CYCLES(group, i);
         /*
          *  The interrupt handler is defined in WDT_VECTOR, which simply clears
          *  the low power mode bits in the Status Register before returning
@@ -262,9 +336,9 @@ void TI_CTS_RO_COMPB_TB0_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param counts pointer to where the measurements are to be written
  *  @return none
  */
-void TI_CTS_fRO_CSIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_fRO_CSIO_TA2_TA3_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
     /*
      *  Allocate Context Save Variables
      *  Status Register: GIE bit only
@@ -294,6 +368,9 @@ void TI_CTS_fRO_CSIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
     TA2CCTL0 = CCIE;
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA2CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
     	/* Enable Capacitive Touch IO oscillation */
 	    *(group->inputCapsioctlRegister)
 	            = ((group->arrayPtr[i])->inputBits)+CAPSIOEN;
@@ -365,9 +442,9 @@ void TI_CTS_fRO_CSIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param counts pointer to where the measurements are to be written
  *  @return        none
  */
-void TI_CTS_RO_CSIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_RO_CSIO_TA2_TA3_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
     /*
      *  Allocate Context Save Variables
      *  Status Register: GIE bit only
@@ -407,6 +484,9 @@ void TI_CTS_RO_CSIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
     TA3CCTL0 = CCIE;
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA3CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
     	/* Enable Capacitive Touch IO oscillation */
 	    *(group->inputCapsioctlRegister)
 	            = ((group->arrayPtr[i])->inputBits)+CAPSIOEN;
@@ -479,9 +559,9 @@ void TI_CTS_RO_CSIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param counts pointer to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_RO_CSIO_TA2_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_RO_CSIO_TA2_WDTA_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
     /*
      *  Allocate Context Save Variables
      *  Status Register: GIE bit only
@@ -526,13 +606,17 @@ void TI_CTS_RO_CSIO_TA2_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
                 
 	    TA2CTL |= (TASSEL_3+MC_2+TACLR);        // Clear Timer_A2 measurement timer
 	    TA2CTL &= ~TAIFG;       // Clear the overflow flag
+#ifdef TIMER2A1_OVERFLOW
+	    ctsOverflowCount = 0;
+	    TA2CTL |= TAIE;         // Count overflows in the high word
+#endif
         /*
          *  The measGateSource represents the gate source for the WDTA, which
          *  can be sourced from ACLK, SMCLK, VLOCLK or X_CLK. The
          *  accumulationCycles represents the watchdog timer interval select.
          */
         WDTCTL = WDTPW+WDTTMSEL+WDTCNTCL+ group->measGateSource
-                + group->accumulationCycles;
+                + ACCUMULATION_CYCLES(group, i);
         /*
          *  The interrupt handler is defined in WDT_VECTOR, which simply clears
          *  the low power mode bits in the Status Register before returning
@@ -547,6 +631,20 @@ void TI_CTS_RO_CSIO_TA2_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
 	        __bis_SR_register(LPM0_bits+GIE);
         }
 	    //TA2CCTL0 ^= CCIS0;  // Create SW capture of TA2R into TA2CCR0
+#ifdef TIMER2A1_OVERFLOW
+        TA2CTL &= ~(MC_2+TAIE);    // Halt Timer
+	    WDTCTL = WDTPW + WDTHOLD;  // Halt watchdog timer
+        if(TA2CTL & TAIFG)
+        {
+            /*
+             *  Account for an overflow between the gate interrupt and the
+             *  timer halt; the overflow ISR counts all earlier ones.
+             */
+            TA2CTL &= ~TAIFG;
+            ctsOverflowCount++;
+        }
+        counts[i] = ((uint32_t)ctsOverflowCount << 16) + TA2R;
+#else
         TA2CTL &= ~MC_2;           // Halt Timer
 	    WDTCTL = WDTPW + WDTHOLD;  // Halt watchdog timer
         if(TA2CTL & TAIFG)
@@ -562,6 +660,7 @@ void TI_CTS_RO_CSIO_TA2_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
         {
             counts[i] = TA2R;  // Save result
         }     
+#endif
     }  // End For Loop
     /* Context restore GIE within Status Register and registers used. */
     *(group->inputCapsioctlRegister) = contextSaveCtl;
@@ -594,9 +693,9 @@ void TI_CTS_RO_CSIO_TA2_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param counts pointer to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_RO_CSIO_TA0_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_RO_CSIO_TA0_WDTA_HAL(const struct Sensor *group,cts_count_t *counts)
 {
-    uint8_t i;
+    uint16_t i;
     /*
      *  Allocate Context Save Variables
      *  Status Register: GIE bit only
@@ -641,13 +740,17 @@ void TI_CTS_RO_CSIO_TA0_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
 	            = ((group->arrayPtr[i])->inputBits)+CAPSIOEN;
 	    TA0CTL = TASSEL_3+MC_2+TACLR;        // Clear Timer_A0 measurement timer
 	    //TA0CTL &= ~TAIFG;       // Clear the overflow flag
+#ifdef TIMER0A1_OVERFLOW
+	    ctsOverflowCount = 0;
+	    TA0CTL |= TAIE;         // Count overflows in the high word
+#endif
         /*
          *  The measGateSource represents the gate source for the WDTA, which
          *  can be sourced from ACLK, SMCLK, VLOCLK or X_CLK. The
          *  accumulationCycles represents the watchdog timer interval select.
          */
         WDTCTL = WDTPW+WDTTMSEL+WDTCNTCL+ group->measGateSource
-                + group->accumulationCycles;
+                + ACCUMULATION_CYCLES(group, i);
         /*
          *  The interrupt handler is defined in WDT_VECTOR, which simply clears
          *  the low power mode bits in the Status Register before returning
@@ -662,6 +765,20 @@ void TI_CTS_RO_CSIO_TA0_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
 	        __bis_SR_register(LPM0_bits+GIE);
         }
 //	    TA0CCTL0 ^= CCIS0;  // Create SW capture of TA0R into TA0CCR0
+#ifdef TIMER0A1_OVERFLOW
+        TA0CTL &= ~(MC_2+TAIE);
+	    WDTCTL = WDTPW + WDTHOLD;  // Halt watchdog timer
+        if(TA0CTL & TAIFG)
+        {
+            /*
+             *  Account for an overflow between the gate interrupt and the
+             *  timer halt; the overflow ISR counts all earlier ones.
+             */
+            TA0CTL &= ~TAIFG;
+            ctsOverflowCount++;
+        }
+        counts[i] = ((uint32_t)ctsOverflowCount << 16) + TA0R;
+#else
         TA0CTL &= ~(MC_2);
 	    WDTCTL = WDTPW + WDTHOLD;  // Halt watchdog timer
         if(TA0CTL & TAIFG)
@@ -677,6 +794,7 @@ void TI_CTS_RO_CSIO_TA0_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
         {
             counts[i] = TA0R;  // Save result
         }
+#endif
 //        TA0CCTL0 &= CCIFG;
     }  // End For Loop
     /* Context restore GIE within Status Register and registers used. */
@@ -710,9 +828,9 @@ void TI_CTS_RO_CSIO_TA0_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param   counts Pointer to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_fRO_PINOSC_TA0_TA1_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_fRO_PINOSC_TA0_TA1_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
 
     /*
      *  Context Save
@@ -752,12 +870,15 @@ void TI_CTS_fRO_PINOSC_TA0_TA1_HAL(const struct Sensor *group,uint16_t *counts)
     
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA0CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
         // Context Save
-        contextSaveSel = *((group->arrayPtr[i])->inputPxselRegister);
-        contextSaveSel2 = *((group->arrayPtr[i])->inputPxsel2Register);
+        contextSaveSel = *ELEMENT_PXSEL(group->arrayPtr[i]);
+        contextSaveSel2 = *ELEMENT_PXSEL2(group->arrayPtr[i]);
         // Configure Ports for relaxation oscillator
-        *((group->arrayPtr[i])->inputPxselRegister) &= ~((group->arrayPtr[i])->inputBits);
-        *((group->arrayPtr[i])->inputPxsel2Register) |= ((group->arrayPtr[i])->inputBits);
+        *ELEMENT_PXSEL(group->arrayPtr[i]) &= ~((group->arrayPtr[i])->inputBits);
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) |= ((group->arrayPtr[i])->inputBits);
 
         // Configure and start measurment timerA1
         TA1CTL = group->measGateSource + MC_2 + TACLR;  // cont
@@ -793,8 +914,8 @@ void TI_CTS_fRO_PINOSC_TA0_TA1_HAL(const struct Sensor *group,uint16_t *counts)
         }
 //        TA1CCTL0 &= ~CCIFG;
         // Context Restore
-        *((group->arrayPtr[i])->inputPxselRegister) = contextSaveSel;
-        *((group->arrayPtr[i])->inputPxsel2Register) = contextSaveSel2;
+        *ELEMENT_PXSEL(group->arrayPtr[i]) = contextSaveSel;
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) = contextSaveSel2;
     } // End for loop
     // Context Restore
     if(!(contextSaveSR & GIE))
@@ -826,9 +947,9 @@ void TI_CTS_fRO_PINOSC_TA0_TA1_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param counts pointer to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_RO_PINOSC_TA0_TA1_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_RO_PINOSC_TA0_TA1_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
     /*!
      *  Allocate Context Save Variables
      *  Status Register: GIE bit only
@@ -870,13 +991,16 @@ void TI_CTS_RO_PINOSC_TA0_TA1_HAL(const struct Sensor *group,uint16_t *counts)
     TA1CCTL0 = CCIE;  // Enable Interrupt when timer counts to TA1CCR0.
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA1CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
         // Context Save Port Registers
-        contextSaveSel = *((group->arrayPtr[i])->inputPxselRegister);
-        contextSaveSel2 = *((group->arrayPtr[i])->inputPxsel2Register);
+        contextSaveSel = *ELEMENT_PXSEL(group->arrayPtr[i]);
+        contextSaveSel2 = *ELEMENT_PXSEL2(group->arrayPtr[i]);
         // Configure Ports for relaxation oscillator
-        *((group->arrayPtr[i])->inputPxselRegister)
+        *ELEMENT_PXSEL(group->arrayPtr[i])
         		&= ~((group->arrayPtr[i])->inputBits);
-        *((group->arrayPtr[i])->inputPxsel2Register)
+        *ELEMENT_PXSEL2(group->arrayPtr[i])
         		|= ((group->arrayPtr[i])->inputBits);
 //        TA0CTL |= TACLR;
 //        TA0CTL &= ~TAIFG;
@@ -915,8 +1039,8 @@ void TI_CTS_RO_PINOSC_TA0_TA1_HAL(const struct Sensor *group,uint16_t *counts)
         }
 //        TA0CCTL0 &= ~CCIFG;
         // Context Restore Port Registers
-        *((group->arrayPtr[i])->inputPxselRegister) = contextSaveSel;
-        *((group->arrayPtr[i])->inputPxsel2Register) = contextSaveSel2;
+        *ELEMENT_PXSEL(group->arrayPtr[i]) = contextSaveSel;
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) = contextSaveSel2;
     } // End for Loop
     /*
      *  Context restore GIE within Status Register and all timer registers
@@ -970,9 +1094,9 @@ void TI_CTS_RO_PINOSC_TA0_TA1_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param   counts Address to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_RO_COMPAp_TA0_WDTp_HAL(const struct Sensor *group, uint16_t *counts)
+void TI_CTS_RO_COMPAp_TA0_WDTp_HAL(const struct Sensor *group, cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
 //** Context Save
 //  Status Register: 
 //  WDTp: IE1, WDTCTL
@@ -1035,7 +1159,7 @@ void TI_CTS_RO_COMPAp_TA0_WDTp_HAL(const struct Sensor *group, uint16_t *counts)
         CACTL2= group->refCactl2Bits + (group->arrayPtr[i])->inputBits;
 	    //**  Setup Gate Timer *****************************************************
 	    // Set duration of sensor measurment
-	    WDTCTL = WDTPW+WDTTMSEL+ group->measGateSource + group->accumulationCycles;
+	    WDTCTL = WDTPW+WDTTMSEL+ group->measGateSource + ACCUMULATION_CYCLES(group, i);
 	    TACTL = TASSEL_0+MC_2+TACLR;                // TACLK, cont mode
 //	    TACTL &= ~TAIFG;                     // Clear Timer_A TAR
         if(group->measGateSource == GATE_WDTp_ACLK)
@@ -1124,9 +1248,9 @@ void TI_CTS_RO_COMPAp_TA0_WDTp_HAL(const struct Sensor *group, uint16_t *counts)
  *  @param   counts Address to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_fRO_COMPAp_TA0_SW_HAL(const struct Sensor *group, uint16_t *counts)
+void TI_CTS_fRO_COMPAp_TA0_SW_HAL(const struct Sensor *group, cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
     uint16_t j;
 //** Context Save
 //  Status Register: 
@@ -1178,6 +1302,9 @@ void TI_CTS_fRO_COMPAp_TA0_SW_HAL(const struct Sensor *group, uint16_t *counts)
     
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA0CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
         j=0;
         CACTL2= group->refCactl2Bits + (group->arrayPtr[i])->inputBits;
         //**  Setup Gate Timer **************
@@ -1246,9 +1373,9 @@ void TI_CTS_fRO_COMPAp_TA0_SW_HAL(const struct Sensor *group, uint16_t *counts)
  *  @param   counts Address to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_fRO_COMPAp_SW_TA0_HAL(const struct Sensor *group, uint16_t *counts)
+void TI_CTS_fRO_COMPAp_SW_TA0_HAL(const struct Sensor *group, cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
     uint16_t j;
     //** Context Save
 //  Status Register: 
@@ -1303,7 +1430,7 @@ void TI_CTS_fRO_COMPAp_SW_TA0_HAL(const struct Sensor *group, uint16_t *counts)
 //        TACCTL0 ^= CCIS0;                     // Create SW capture of CCR0
         //**  Setup Gate Timer **************
         // Set duration of sensor measurment
-        for(j = group->accumulationCycles; j > 0; j--)
+        for(j = ACCUMULATION_CYCLES(group, i); j > 0; j--)
         {
             CACTL1 &= ~CAIFG;
             while(!(CACTL1 & CAIFG));
@@ -1378,9 +1505,9 @@ void TI_CTS_fRO_COMPAp_SW_TA0_HAL(const struct Sensor *group, uint16_t *counts)
  *  @param   counts Address to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_RO_COMPAp_TA1_WDTp_HAL(const struct Sensor *group, uint16_t *counts)
+void TI_CTS_RO_COMPAp_TA1_WDTp_HAL(const struct Sensor *group, cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
 //** Context Save
 //  Status Register: 
 //  WDTp: IE1, WDTCTL
@@ -1447,7 +1574,7 @@ void TI_CTS_RO_COMPAp_TA1_WDTp_HAL(const struct Sensor *group, uint16_t *counts)
         CACTL2= group->refCactl2Bits + (group->arrayPtr[i])->inputBits;
         //**  Setup Gate Timer *****************************************************
         // Set duration of sensor measurment
-        WDTCTL = WDTPW+WDTTMSEL+ group->measGateSource + group->accumulationCycles;
+        WDTCTL = WDTPW+WDTTMSEL+ group->measGateSource + ACCUMULATION_CYCLES(group, i);
         TA1CTL = TASSEL_0+MC_2+TACLR;                // TA1CLK, cont mode
 //       TA1CTL |= TACLR;                     // Clear Timer_A TAR
         if(group->measGateSource == GATE_WDTp_ACLK)
@@ -1540,9 +1667,9 @@ void TI_CTS_RO_COMPAp_TA1_WDTp_HAL(const struct Sensor *group, uint16_t *counts)
  *  @param   counts Address to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_fRO_COMPAp_TA1_SW_HAL(const struct Sensor *group, uint16_t *counts)
+void TI_CTS_fRO_COMPAp_TA1_SW_HAL(const struct Sensor *group, cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
     uint16_t j;
     //** Context Save
 //  Status Register: 
@@ -1594,6 +1721,9 @@ void TI_CTS_fRO_COMPAp_TA1_SW_HAL(const struct Sensor *group, uint16_t *counts)
     
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA1CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
         j=0;
         CACTL2= group->refCactl2Bits + (group->arrayPtr[i])->inputBits;
         //**  Setup Gate Timer **************
@@ -1661,9 +1791,9 @@ void TI_CTS_fRO_COMPAp_TA1_SW_HAL(const struct Sensor *group, uint16_t *counts)
  *  @param   counts Address to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_RC_PAIR_TA0_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_RC_PAIR_TA0_HAL(const struct Sensor *group,cts_count_t *counts)
 {
-    uint8_t i;
+    uint16_t i;
 	uint16_t j;
     
     //** Context Save
@@ -1689,11 +1819,11 @@ void TI_CTS_RC_PAIR_TA0_HAL(const struct Sensor *group,uint16_t *counts)
     for (i = 0; i<(group->numElements); i++)
     {
         // Context Save
-        contextSaveinputPxout = *((group->arrayPtr[i])->inputPxoutRegister);
-        contextSaveinputPxdir = *((group->arrayPtr[i])->inputPxdirRegister);
-        contextSavereferencePxout = *((group->arrayPtr[i])->referencePxoutRegister);
-        contextSavereferencePxdir = *((group->arrayPtr[i])->referencePxdirRegister);
-        j = (group->accumulationCycles);
+        contextSaveinputPxout = *ELEMENT_PXOUT(group->arrayPtr[i]);
+        contextSaveinputPxdir = *ELEMENT_PXDIR(group->arrayPtr[i]);
+        contextSavereferencePxout = *ELEMENT_REF_PXOUT(group->arrayPtr[i]);
+        contextSavereferencePxdir = *ELEMENT_REF_PXDIR(group->arrayPtr[i]);
+        j = ACCUMULATION_CYCLES(group, i);
         #ifdef __MSP430_HAS_SFR__
 	    TA0CTL = group->measGateSource+group->sourceScale+TACLR;   // SMCLK, up mode
         #else
@@ -1708,15 +1838,15 @@ void TI_CTS_RC_PAIR_TA0_HAL(const struct Sensor *group,uint16_t *counts)
 	    //              +---- Rerefence (high)
         //******************************************************************************
 	    // Input low
-        *((group->arrayPtr[i])->inputPxoutRegister) &= ~((group->arrayPtr[i])->inputBits);
-	    *((group->arrayPtr[i])->inputPxdirRegister) |= (group->arrayPtr[i])->inputBits;
+        *ELEMENT_PXOUT(group->arrayPtr[i]) &= ~((group->arrayPtr[i])->inputBits);
+	    *ELEMENT_PXDIR(group->arrayPtr[i]) |= (group->arrayPtr[i])->inputBits;
         // Reference High
-        *((group->arrayPtr[i])->referencePxdirRegister) |= (group->arrayPtr[i])->referenceBits;
-        *((group->arrayPtr[i])->referencePxoutRegister) |= ((group->arrayPtr[i])->referenceBits);
+        *ELEMENT_REF_PXDIR(group->arrayPtr[i]) |= (group->arrayPtr[i])->referenceBits;
+        *ELEMENT_REF_PXOUT(group->arrayPtr[i]) |= ((group->arrayPtr[i])->referenceBits);
         // Wait until low
-	    while((*((group->arrayPtr[i])->inputPxinRegister)) & ((group->arrayPtr[i])->inputBits));
+	    while((*ELEMENT_PXIN(group->arrayPtr[i])) & ((group->arrayPtr[i])->inputBits));
         // Change to an input
-        *((group->arrayPtr[i])->inputPxdirRegister) &= ~(group->arrayPtr[i])->inputBits;
+        *ELEMENT_PXDIR(group->arrayPtr[i]) &= ~(group->arrayPtr[i])->inputBits;
 	    //**************************************************************************
 	    // This mechanism is traditianally an LPM with the ISR calculating the 
 	    // delta between when the first snapshot and the ISR event.  If this is
@@ -1731,7 +1861,7 @@ void TI_CTS_RC_PAIR_TA0_HAL(const struct Sensor *group,uint16_t *counts)
         TACTL |= MC_1;                     // start timer
         #endif
 	    //wait until voltage reaches Vih of port
-	    while(!((*((group->arrayPtr[i])->inputPxinRegister) & (group->arrayPtr[i])->inputBits)));
+	    while(!((*ELEMENT_PXIN(group->arrayPtr[i]) & (group->arrayPtr[i])->inputBits)));
         #ifdef __MSP430_HAS_SFR__
         TA0CTL &= ~ MC_3;                     // stop timer
         #else
@@ -1746,19 +1876,19 @@ void TI_CTS_RC_PAIR_TA0_HAL(const struct Sensor *group,uint16_t *counts)
          ******************************************************************************
          */
 	    // Input High
-        *((group->arrayPtr[i])->inputPxoutRegister) |= ((group->arrayPtr[i])->inputBits);
-        *((group->arrayPtr[i])->inputPxdirRegister) |= (group->arrayPtr[i])->inputBits;
+        *ELEMENT_PXOUT(group->arrayPtr[i]) |= ((group->arrayPtr[i])->inputBits);
+        *ELEMENT_PXDIR(group->arrayPtr[i]) |= (group->arrayPtr[i])->inputBits;
 	    // Reference Low
-	    *((group->arrayPtr[i])->referencePxoutRegister) &= ~((group->arrayPtr[i])->referenceBits);
+	    *ELEMENT_REF_PXOUT(group->arrayPtr[i]) &= ~((group->arrayPtr[i])->referenceBits);
 	    // Change to an input
-	    *((group->arrayPtr[i])->inputPxdirRegister) &= ~((group->arrayPtr[i])->inputBits);
+	    *ELEMENT_PXDIR(group->arrayPtr[i]) &= ~((group->arrayPtr[i])->inputBits);
         #ifdef __MSP430_HAS_SFR__
         TA0CTL |= MC_1;                     // start timer
         #else
         TACTL |= MC_1;                     // start timer
         #endif
 	    //wait until voltage reaches Vil of port  
-	    while((*((group->arrayPtr[i])->inputPxinRegister)) & ((group->arrayPtr[i])->inputBits));
+	    while((*ELEMENT_PXIN(group->arrayPtr[i])) & ((group->arrayPtr[i])->inputBits));
         #ifdef __MSP430_HAS_SFR__
         TA0CTL &= ~ MC_3;                     // stop timer
         #else
@@ -1785,10 +1915,10 @@ void TI_CTS_RC_PAIR_TA0_HAL(const struct Sensor *group,uint16_t *counts)
         }
         #endif
         // Context Restore
-        *((group->arrayPtr[i])->inputPxoutRegister) = contextSaveinputPxout;
-        *((group->arrayPtr[i])->inputPxdirRegister) = contextSaveinputPxdir;     
-        *((group->arrayPtr[i])->referencePxoutRegister) = contextSavereferencePxout;
-        *((group->arrayPtr[i])->referencePxdirRegister) = contextSavereferencePxdir;             
+        *ELEMENT_PXOUT(group->arrayPtr[i]) = contextSaveinputPxout;
+        *ELEMENT_PXDIR(group->arrayPtr[i]) = contextSaveinputPxdir;     
+        *ELEMENT_REF_PXOUT(group->arrayPtr[i]) = contextSavereferencePxout;
+        *ELEMENT_REF_PXDIR(group->arrayPtr[i]) = contextSavereferencePxdir;             
     } // END FOR loop which cycles through elements within sensor
     
     //** Context Restore
@@ -1822,9 +1952,9 @@ void TI_CTS_RC_PAIR_TA0_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param   counts Address to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_fRO_PINOSC_TA0_SW_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_fRO_PINOSC_TA0_SW_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
     uint16_t j;
 //** Context Save
 //  TIMERA0: TA0CTL
@@ -1838,13 +1968,16 @@ void TI_CTS_fRO_PINOSC_TA0_SW_HAL(const struct Sensor *group,uint16_t *counts)
     TA0CCR0 =(group->accumulationCycles);
     for (i =0; i< (group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA0CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
         j = 0;
         // Context Save
-        contextSaveSel = *((group->arrayPtr[i])->inputPxselRegister);
-        contextSaveSel2 = *((group->arrayPtr[i])->inputPxsel2Register);
+        contextSaveSel = *ELEMENT_PXSEL(group->arrayPtr[i]);
+        contextSaveSel2 = *ELEMENT_PXSEL2(group->arrayPtr[i]);
         // start single oscillation (rise then fall and trigger on fall)
-        *((group->arrayPtr[i])->inputPxselRegister) &= ~((group->arrayPtr[i])->inputBits);
-        *((group->arrayPtr[i])->inputPxsel2Register) |= ((group->arrayPtr[i])->inputBits);
+        *ELEMENT_PXSEL(group->arrayPtr[i]) &= ~((group->arrayPtr[i])->inputBits);
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) |= ((group->arrayPtr[i])->inputBits);
 		TA0CCTL0 &= ~CCIFG;
         TA0CTL = TASSEL_3+TACLR+MC_1;      // INCLK, reset, up mode   
 //        TA0CTL &= ~TAIFG;                  // clear IFG                
@@ -1856,8 +1989,8 @@ void TI_CTS_fRO_PINOSC_TA0_SW_HAL(const struct Sensor *group,uint16_t *counts)
         counts[i] = j;   
         TA0CTL &= ~MC_1;
         // Context Restore
-        *((group->arrayPtr[i])->inputPxselRegister) = contextSaveSel;
-        *((group->arrayPtr[i])->inputPxsel2Register) = contextSaveSel2;                        
+        *ELEMENT_PXSEL(group->arrayPtr[i]) = contextSaveSel;
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) = contextSaveSel2;                        
     }
     // End Sequence
     // Context Restore
@@ -1867,6 +2000,137 @@ void TI_CTS_fRO_PINOSC_TA0_SW_HAL(const struct Sensor *group,uint16_t *counts)
 }
 #endif 
 
+#ifdef fRO_PINOSC_TA0_TA1CAP
+/*!
+ *  @brief   fRO method capacitance measurement using the PinOsc, TimerA0 and
+ *           the capture unit of TimerA1
+ *
+ *  \n       Schematic Description: 
+ * 
+ *  \n       element-----+->Px.y
+ * 
+ *  \n       TimerA0 counts n oscillation cycles of the element (INCLK) in up
+ *           mode, 'n' is defined by the variable accumulation_cycles.
+ *           TimerA1 runs continuously from measGateSource.  A software
+ *           capture of TA1R is taken when TimerA0 is started and again in the
+ *           TIMER0_A0_VECTOR interrupt when n cycles have elapsed.  The
+ *           difference of the two captures is the length of the window in
+ *           TimerA1 clocks, which is directly proportional to the capacitance
+ *           of the element.
+ *  \n       Unlike fRO_PINOSC_TA0_SW the result does not depend on the
+ *           compiler or on the code executed during the measurement, and the
+ *           CPU waits in LPM0 (LPM3 when TimerA1 is sourced from ACLK).
+ * 
+ *  @param   group Pointer to the structure describing the Sensor to be measured
+ *  @param   counts Pointer to where the measurements are to be written
+ *  @return  none
+ */
+void TI_CTS_fRO_PINOSC_TA0_TA1CAP_HAL(const struct Sensor *group,cts_count_t *counts)
+{ 
+    uint16_t i;
+    uint16_t startCapture;
+
+    /*
+     *  Context Save
+     *  Status Register: GIE
+     *  TIMERA0: TA0CTL, TA0CCTL0, TA0CCR0
+     *  TIMERA1: TA1CTL, TA1CCTL1, TA1CCR1
+     *  Ports: PxSEL, PxSEL2
+     */
+    uint8_t contextSaveSR; 
+    uint16_t contextSaveTA0CTL,contextSaveTA0CCTL0,contextSaveTA0CCR0;
+    uint16_t contextSaveTA1CTL,contextSaveTA1CCTL1,contextSaveTA1CCR1;
+    uint8_t contextSaveSel,contextSaveSel2;
+
+    contextSaveSR = __get_SR_register();
+    contextSaveTA0CTL = TA0CTL;
+    contextSaveTA0CCTL0 = TA0CCTL0;
+    contextSaveTA0CCR0 = TA0CCR0;
+    contextSaveTA1CTL = TA1CTL;
+    contextSaveTA1CCTL1 = TA1CCTL1;
+    contextSaveTA1CCR1 = TA1CCR1;
+    
+    // Configure Measurement interval with TimerA0
+    TA0CCR0 = (group->accumulationCycles);
+    /*
+     *  INCLK, IDx settings from sourceScale definition
+     */
+    TA0CTL = TASSEL_3 + group->sourceScale;
+    TA0CCTL0 = CCIE;
+    // Capture unit of TimerA1: both edges, GND, synchronous
+    TA1CCTL1 = CM_3+CCIS_2+CAP+SCS;
+    
+    for (i = 0; i<(group->numElements); i++)
+    {
+#ifdef ELEMENT_GATE
+        TA0CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
+        // Context Save
+        contextSaveSel = *ELEMENT_PXSEL(group->arrayPtr[i]);
+        contextSaveSel2 = *ELEMENT_PXSEL2(group->arrayPtr[i]);
+        // Configure Ports for relaxation oscillator
+        *ELEMENT_PXSEL(group->arrayPtr[i]) &= ~((group->arrayPtr[i])->inputBits);
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) |= ((group->arrayPtr[i])->inputBits);
+
+        /*
+         *  In this configuration measGateSource represents the clock source
+         *  for timer TIMERA1, which can be sourced from TACLK, ACLK, SMCLK, or
+         *  INCLK.
+         */
+        TA1CTL = group->measGateSource + MC_2 + TACLR;  // cont
+        TA0CTL |= (TACLR + MC_1);  // Clear Timer, Up mode
+        TA1CCTL1 ^= CCIS0;         // SW capture, start of window
+        while(!(TA1CCTL1 & CCIFG)); // wait for synchronous capture
+        TA1CCTL1 &= ~CCIFG;
+        startCapture = TA1CCR1;
+        /*
+         *  The TIMER0_A0_VECTOR interrupt takes the second capture before
+         *  returning from low power mode.
+         */
+        if(group->measGateSource == TIMER_ACLK)
+        {
+            __bis_SR_register(LPM3_bits+GIE);
+        }
+        else
+        {
+            __bis_SR_register(LPM0_bits+GIE);
+        }
+        while(!(TA1CCTL1 & CCIFG)); // wait for synchronous capture
+        TA1CTL &= ~MC_2;
+        TA0CTL &= ~MC_1;          // Halt Timer
+        if((TA1CTL & TAIFG) || (TA1CCTL1 & COV))
+        {
+            /*
+             *  If a rollover in the timer or a missed capture has occurred
+             *  then set counts to 0.  This will prevent erroneous data from
+             *  entering the baseline tracking algorithm.
+             */
+            counts[i] = 0;
+        }
+        else
+        {
+            counts[i] = TA1CCR1 - startCapture;      // Save result
+        }
+        TA1CTL &= ~TAIFG;
+        TA1CCTL1 &= ~(CCIFG + COV);
+        // Context Restore
+        *ELEMENT_PXSEL(group->arrayPtr[i]) = contextSaveSel;
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) = contextSaveSel2;
+    } // End for loop
+    // Context Restore
+    if(!(contextSaveSR & GIE))
+    {
+        __bic_SR_register(GIE);
+    }
+    TA0CTL = contextSaveTA0CTL;
+    TA0CCTL0 = contextSaveTA0CCTL0;
+    TA0CCR0 = contextSaveTA0CCR0;
+    TA1CTL = contextSaveTA1CTL;
+    TA1CCTL1 = contextSaveTA1CCTL1;
+    TA1CCR1 = contextSaveTA1CCR1;
+}
+#endif
+
 #ifdef RO_PINOSC_TA0_WDTp
 /*!
  *  @brief   RO method capactiance measurement with PinOsc IO, TimerA0, and WDT+
@@ -1883,9 +2147,9 @@ void TI_CTS_fRO_PINOSC_TA0_SW_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param   counts Pointer to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_RO_PINOSC_TA0_WDTp_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_RO_PINOSC_TA0_WDTp_HAL(const struct Sensor *group,cts_count_t *counts)
 {
-    uint8_t i;
+    uint16_t i;
 
 //** Context Save
 //  Status Register:
@@ -1915,16 +2179,20 @@ void TI_CTS_RO_PINOSC_TA0_WDTp_HAL(const struct Sensor *group,uint16_t *counts)
     for (i = 0; i<(group->numElements); i++)
     {
         // Context Save
-        contextSaveSel = *((group->arrayPtr[i])->inputPxselRegister);
-        contextSaveSel2 = *((group->arrayPtr[i])->inputPxsel2Register);
+        contextSaveSel = *ELEMENT_PXSEL(group->arrayPtr[i]);
+        contextSaveSel2 = *ELEMENT_PXSEL2(group->arrayPtr[i]);
 	      // Configure Ports for relaxation oscillator
-	      *((group->arrayPtr[i])->inputPxselRegister) &= ~((group->arrayPtr[i])->inputBits);
-	      *((group->arrayPtr[i])->inputPxsel2Register) |= ((group->arrayPtr[i])->inputBits);
+	      *ELEMENT_PXSEL(group->arrayPtr[i]) &= ~((group->arrayPtr[i])->inputBits);
+	      *ELEMENT_PXSEL2(group->arrayPtr[i]) |= ((group->arrayPtr[i])->inputBits);
         //**  Setup Gate Timer ********************************************************
 	    // Set duration of sensor measurment
-        WDTCTL = (WDTPW+WDTTMSEL+(group->measGateSource)+(group->accumulationCycles));
+        WDTCTL = (WDTPW+WDTTMSEL+(group->measGateSource)+ACCUMULATION_CYCLES(group, i));
         TA0CTL |= (MC_2+TACLR);                          // Clear Timer_A TAR
         TA0CTL &= ~TAIFG;
+#ifdef TIMER0A1_OVERFLOW
+        ctsOverflowCount = 0;
+        TA0CTL |= TAIE;                     // Count overflows in high word
+#endif
         if(group->measGateSource == GATE_WDT_ACLK)
         {
             __bis_SR_register(LPM3_bits+GIE);   // Wait for WDT interrupt
@@ -1933,6 +2201,17 @@ void TI_CTS_RO_PINOSC_TA0_WDTp_HAL(const struct Sensor *group,uint16_t *counts)
         {
             __bis_SR_register(LPM0_bits+GIE);   // Wait for WDT interrupt
         }
+#ifdef TIMER0A1_OVERFLOW
+        TA0CTL &= ~(MC_2+TAIE);             // Stop Timer_A TAR
+        WDTCTL = WDTPW + WDTHOLD;           // Stop watchdog timer
+        if(TA0CTL & TAIFG)
+        {
+            // overflow between the gate interrupt and the timer halt
+            TA0CTL &= ~TAIFG;
+            ctsOverflowCount++;
+        }
+        counts[i] = ((uint32_t)ctsOverflowCount << 16) + TA0R;
+#else
         TA0CTL &= ~MC_2;                    // Stop Timer_A TAR
         WDTCTL = WDTPW + WDTHOLD;           // Stop watchdog timer
         if(TA0CTL & TAIFG)
@@ -1944,10 +2223,11 @@ void TI_CTS_RO_PINOSC_TA0_WDTp_HAL(const struct Sensor *group,uint16_t *counts)
         {
         	counts[i] = TA0R;   // Save result
         }
+#endif
 
         // Context Restore
-        *((group->arrayPtr[i])->inputPxselRegister) = contextSaveSel;
-        *((group->arrayPtr[i])->inputPxsel2Register) = contextSaveSel2;
+        *ELEMENT_PXSEL(group->arrayPtr[i]) = contextSaveSel;
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) = contextSaveSel2;
     }
     // End Sequence
     // Context Restore
@@ -1979,9 +2259,9 @@ void TI_CTS_RO_PINOSC_TA0_WDTp_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param   counts Pointer to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_RO_PINOSC_TA0_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_RO_PINOSC_TA0_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
 	uint16_t j;
     //** Context Save
 //  TIMERA0: TA0CTL, TA0CCTL0
@@ -2002,12 +2282,12 @@ void TI_CTS_RO_PINOSC_TA0_HAL(const struct Sensor *group,uint16_t *counts)
 	for (i =0; i< (group->numElements); i++)
 	{
         // Context Save
-        contextSaveSel = *((group->arrayPtr[i])->inputPxselRegister);
-        contextSaveSel2 = *((group->arrayPtr[i])->inputPxsel2Register);
+        contextSaveSel = *ELEMENT_PXSEL(group->arrayPtr[i]);
+        contextSaveSel2 = *ELEMENT_PXSEL2(group->arrayPtr[i]);
 	    // Configure Ports for relaxation oscillator
-	    j = (group->accumulationCycles);
-	    *((group->arrayPtr[i])->inputPxselRegister) &= ~((group->arrayPtr[i])->inputBits);
-	    *((group->arrayPtr[i])->inputPxsel2Register) |= ((group->arrayPtr[i])->inputBits);
+	    j = ACCUMULATION_CYCLES(group, i);
+	    *ELEMENT_PXSEL(group->arrayPtr[i]) &= ~((group->arrayPtr[i])->inputBits);
+	    *ELEMENT_PXSEL2(group->arrayPtr[i]) |= ((group->arrayPtr[i])->inputBits);
 	    TA0CCTL0 = CM_3+CCIS_1+CAP;            // Pos&Neg,ACLK (CCI0B),Cap
 	    while(!(TA0CCTL0 & CCIFG));             // wait for capture event  
 //	    TA0CTL |= TACLR;                       // Clear Timer_A TAR
@@ -2022,8 +2302,8 @@ void TI_CTS_RO_PINOSC_TA0_HAL(const struct Sensor *group,uint16_t *counts)
 //        counts[i] = TA0CCR0;                    // Save result
 //        TA0CTL = TASSEL_3+MC_2;                        
         // Context Restore
-        *((group->arrayPtr[i])->inputPxselRegister) = contextSaveSel;
-        *((group->arrayPtr[i])->inputPxsel2Register) = contextSaveSel2;
+        *ELEMENT_PXSEL(group->arrayPtr[i]) = contextSaveSel;
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) = contextSaveSel2;
     }
     // End Sequence
     // Context Restore
@@ -2056,9 +2336,9 @@ void TI_CTS_RO_PINOSC_TA0_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param   counts Address to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_RO_COMPB_TA0_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_RO_COMPB_TA0_WDTA_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-   uint8_t i;
+   uint16_t i;
     
 //** Context Save
 //  Status Register: 
@@ -2116,7 +2396,7 @@ void TI_CTS_RO_COMPB_TA0_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
         //**  Setup Gate Timer *************************************************
         // Set duration of sensor measurment
         WDTCTL = WDTPW + WDTTMSEL + group->measGateSource 
-		           + group->accumulationCycles;
+		           + ACCUMULATION_CYCLES(group, i);
 //        TA0CTL |= TACLR;                     // Clear Timer_A TAR
 		TA0CTL = TASSEL_0+MC_2+TACLR;                // TACLK, cont mode
         if(group->measGateSource == GATE_WDTA_ACLK)
@@ -2180,9 +2460,9 @@ void TI_CTS_RO_COMPB_TA0_WDTA_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param   counts Address to where the measurements are to be written
  *  @return  none
  ******************************************************************************/
-void TI_CTS_RO_COMPB_TA1_WDTA_HAL(const struct Sensor *group, uint16_t *counts)
+void TI_CTS_RO_COMPB_TA1_WDTA_HAL(const struct Sensor *group, cts_count_t *counts)
 { 
-    uint8_t i=0;
+    uint16_t i=0;
     
     //** Context Save
 //  Status Register: 
@@ -2233,7 +2513,7 @@ void TI_CTS_RO_COMPB_TA1_WDTA_HAL(const struct Sensor *group, uint16_t *counts)
         //**  Setup Gate Timer *************************************************
         // Set duration of sensor measurment
 	    WDTCTL = WDTPW + WDTTMSEL + WDTCNTCL
-	    		+ group->measGateSource + group->accumulationCycles;
+	    		+ group->measGateSource + ACCUMULATION_CYCLES(group, i);
 	    // Configure Timer TA1
 	    TA1CTL = TASSEL_0+MC_2+TACLR;                // TACLK, cont mode
 	    TA1CTL &= ~TAIFG;                            // Clear Timer_A IFG
@@ -2306,9 +2586,9 @@ void TI_CTS_RO_COMPB_TA1_WDTA_HAL(const struct Sensor *group, uint16_t *counts)
  *  @param   counts Address to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_fRO_COMPB_TA0_SW_HAL(const struct Sensor *group, uint16_t *counts)
+void TI_CTS_fRO_COMPB_TA0_SW_HAL(const struct Sensor *group, cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
     uint16_t j;
     
 //** Context Save
@@ -2349,6 +2629,9 @@ void TI_CTS_fRO_COMPB_TA0_SW_HAL(const struct Sensor *group, uint16_t *counts)
     CBCTL2 |= CBRS_1;                          // Turn on reference
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA0CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
         j=0;
         CBCTL0 = CBIMEN + (group->arrayPtr[i])->inputBits;                                         
         //**  Setup Gate Timer *************************************************
@@ -2402,9 +2685,9 @@ void TI_CTS_fRO_COMPB_TA0_SW_HAL(const struct Sensor *group, uint16_t *counts)
  *  @param   counts Address to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_fRO_COMPB_TA1_SW_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_fRO_COMPB_TA1_SW_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
     uint16_t j;
 //** Context Save
 //  TIMERA0: TA1CTL, TA1CCTL1
@@ -2443,6 +2726,9 @@ void TI_CTS_fRO_COMPB_TA1_SW_HAL(const struct Sensor *group,uint16_t *counts)
     CBCTL2 |= CBRS_1;                          // Turn on reference
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA1CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
         j=0;
         CBCTL0 = CBIMEN + (group->arrayPtr[i])->inputBits;                                         
         //**  Setup Gate Timer *************************************************
@@ -2496,9 +2782,9 @@ void TI_CTS_fRO_COMPB_TA1_SW_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param counts pointer to where the measurements are to be written
  *  @return        none
  */
-void TI_CTS_RO_COMPB_TA1_TA0_HAL(const struct Sensor *group, uint16_t *counts)
+void TI_CTS_RO_COMPB_TA1_TA0_HAL(const struct Sensor *group, cts_count_t *counts)
 { 
-    uint8_t i=0;
+    uint16_t i=0;
     
     /*!
      *  Allocate Context Save Variables
@@ -2556,6 +2842,9 @@ void TI_CTS_RO_COMPB_TA1_TA0_HAL(const struct Sensor *group, uint16_t *counts)
     CBCTL1 = CBON;                          // Turn on COMPB w/out filter
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA0CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
         /* Turn on specific comparator input. */
         CBCTL0 = CBIMEN + (group->arrayPtr[i])->inputBits;
         /*
@@ -2645,9 +2934,9 @@ void TI_CTS_RO_COMPB_TA1_TA0_HAL(const struct Sensor *group, uint16_t *counts)
  *  @param (counts) pointer to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_fRO_COMPB_TA1_TA0_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_fRO_COMPB_TA1_TA0_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-    uint8_t i=0;
+    uint16_t i=0;
 
     /*!
      *  Allocate Context Save Variables
@@ -2713,6 +3002,9 @@ void TI_CTS_fRO_COMPB_TA1_TA0_HAL(const struct Sensor *group,uint16_t *counts)
     CBCTL1 = CBON;                          // Turn on COMPB w/out filter
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA1CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
         /*
          *  Turn on specific comparator input.
          */
@@ -2794,9 +3086,9 @@ void TI_CTS_fRO_COMPB_TA1_TA0_HAL(const struct Sensor *group,uint16_t *counts)
  *  @return  none
  */
 
-void TI_CTS_RO_PINOSC_TA1_WDTp_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_RO_PINOSC_TA1_WDTp_HAL(const struct Sensor *group,cts_count_t *counts)
 {
-    uint8_t i;
+    uint16_t i;
 
 //** Context Save
 //  Status Register:
@@ -2824,17 +3116,21 @@ void TI_CTS_RO_PINOSC_TA1_WDTp_HAL(const struct Sensor *group,uint16_t *counts)
     for (i = 0; i<(group->numElements); i++)
     {
         // Context Save
-        contextSaveSel = *((group->arrayPtr[i])->inputPxselRegister);
-        contextSaveSel2 = *((group->arrayPtr[i])->inputPxsel2Register);
+        contextSaveSel = *ELEMENT_PXSEL(group->arrayPtr[i]);
+        contextSaveSel2 = *ELEMENT_PXSEL2(group->arrayPtr[i]);
 	      // Configure Ports for relaxation oscillator
-	      *((group->arrayPtr[i])->inputPxselRegister) &= ~((group->arrayPtr[i])->inputBits);
-	      *((group->arrayPtr[i])->inputPxsel2Register) |= ((group->arrayPtr[i])->inputBits);
+	      *ELEMENT_PXSEL(group->arrayPtr[i]) &= ~((group->arrayPtr[i])->inputBits);
+	      *ELEMENT_PXSEL2(group->arrayPtr[i]) |= ((group->arrayPtr[i])->inputBits);
         //**  Setup Gate Timer ********************************************************
 	      // Set duration of sensor measurment
-        WDTCTL = (WDTPW+WDTTMSEL+(group->measGateSource)+(group->accumulationCycles));
+        WDTCTL = (WDTPW+WDTTMSEL+(group->measGateSource)+ACCUMULATION_CYCLES(group, i));
         // Configure and Start Timer
         TA1CTL = TASSEL_3+MC_2+TACLR;                // INCLK, continuous mode
         TA1CTL &= ~TAIFG;
+#ifdef TIMER1A1_OVERFLOW
+        ctsOverflowCount = 0;
+        TA1CTL |= TAIE;                    // Count overflows in high word
+#endif
         if(group->measGateSource == GATE_WDT_ACLK)
         {
             __bis_SR_register(LPM3_bits+GIE);   // Wait for WDT interrupt
@@ -2843,6 +3139,17 @@ void TI_CTS_RO_PINOSC_TA1_WDTp_HAL(const struct Sensor *group,uint16_t *counts)
         {
 	        __bis_SR_register(LPM0_bits+GIE);   // Wait for WDT interrupt
         }
+#ifdef TIMER1A1_OVERFLOW
+	    TA1CTL &= ~(MC_2+TAIE);            // Halt Timer
+	    WDTCTL = WDTPW + WDTHOLD;          // Stop watchdog timer
+	    if(TA1CTL & TAIFG)
+	    {
+	        // overflow between the gate interrupt and the timer halt
+	        TA1CTL &= ~TAIFG;
+	        ctsOverflowCount++;
+	    }
+	    counts[i] = ((uint32_t)ctsOverflowCount << 16) + TA1R;
+#else
 	    TA1CTL &= ~MC_2;                   // Halt Timer
 	    WDTCTL = WDTPW + WDTHOLD;          // Stop watchdog timer
 	    if(TA1CTL & TAIFG)
@@ -2853,9 +3160,10 @@ void TI_CTS_RO_PINOSC_TA1_WDTp_HAL(const struct Sensor *group,uint16_t *counts)
 	    {
 	        counts[i] = TA1R;               // Save result
 	    }
+#endif
         // Context Restore
-        *((group->arrayPtr[i])->inputPxselRegister) = contextSaveSel;
-        *((group->arrayPtr[i])->inputPxsel2Register) = contextSaveSel2;
+        *ELEMENT_PXSEL(group->arrayPtr[i]) = contextSaveSel;
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) = contextSaveSel2;
     }
     // End Sequence
     // Context Restore
@@ -2888,9 +3196,9 @@ void TI_CTS_RO_PINOSC_TA1_WDTp_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param counts pointer to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_RO_PINOSC_TA1_TB0_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_RO_PINOSC_TA1_TB0_HAL(const struct Sensor *group,cts_count_t *counts)
 {
-    uint8_t i;
+    uint16_t i;
     /*!
      *  Allocate Context Save Variables
      *  Status Register: GIE bit only
@@ -2926,13 +3234,16 @@ void TI_CTS_RO_PINOSC_TA1_TB0_HAL(const struct Sensor *group,uint16_t *counts)
     TB0CCTL0 = CCIE;  // Enable Interrupt when timer counts to TB0CCR0.
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TB0CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
         // Context Save Port Registers
-        contextSaveSel = *((group->arrayPtr[i])->inputPxselRegister);
-        contextSaveSel2 = *((group->arrayPtr[i])->inputPxsel2Register);
+        contextSaveSel = *ELEMENT_PXSEL(group->arrayPtr[i]);
+        contextSaveSel2 = *ELEMENT_PXSEL2(group->arrayPtr[i]);
         // Configure Ports for relaxation oscillator
-        *((group->arrayPtr[i])->inputPxselRegister)
+        *ELEMENT_PXSEL(group->arrayPtr[i])
         		&= ~((group->arrayPtr[i])->inputBits);
-        *((group->arrayPtr[i])->inputPxsel2Register)
+        *ELEMENT_PXSEL2(group->arrayPtr[i])
         		|= ((group->arrayPtr[i])->inputBits);
         /*
          *  TimerA1 is the measurement timer and counts the number of relaxation
@@ -2974,8 +3285,8 @@ void TI_CTS_RO_PINOSC_TA1_TB0_HAL(const struct Sensor *group,uint16_t *counts)
             counts[i] = TA1R;  // Save result
         }
         // Context Restore Port Registers
-        *((group->arrayPtr[i])->inputPxselRegister) = contextSaveSel;
-        *((group->arrayPtr[i])->inputPxsel2Register) = contextSaveSel2;
+        *ELEMENT_PXSEL(group->arrayPtr[i]) = contextSaveSel;
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) = contextSaveSel2;
     } // End for Loop
     /*
      *  Context restore GIE within Status Register and all timer registers
@@ -3010,9 +3321,9 @@ void TI_CTS_RO_PINOSC_TA1_TB0_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param   counts Pointer to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_fRO_PINOSC_TA1_TA0_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_fRO_PINOSC_TA1_TA0_HAL(const struct Sensor *group,cts_count_t *counts)
 {
-    uint8_t i;
+    uint16_t i;
 
     /*
      *  Context Save
@@ -3052,12 +3363,15 @@ void TI_CTS_fRO_PINOSC_TA1_TA0_HAL(const struct Sensor *group,uint16_t *counts)
 
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA1CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
         // Context Save
-        contextSaveSel = *((group->arrayPtr[i])->inputPxselRegister);
-        contextSaveSel2 = *((group->arrayPtr[i])->inputPxsel2Register);
+        contextSaveSel = *ELEMENT_PXSEL(group->arrayPtr[i]);
+        contextSaveSel2 = *ELEMENT_PXSEL2(group->arrayPtr[i]);
         // Configure Ports for relaxation oscillator
-        *((group->arrayPtr[i])->inputPxselRegister) &= ~((group->arrayPtr[i])->inputBits);
-        *((group->arrayPtr[i])->inputPxsel2Register) |= ((group->arrayPtr[i])->inputBits);
+        *ELEMENT_PXSEL(group->arrayPtr[i]) &= ~((group->arrayPtr[i])->inputBits);
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) |= ((group->arrayPtr[i])->inputBits);
 
 //        TA0CTL |= TACLR;
         /*
@@ -3097,8 +3411,8 @@ void TI_CTS_fRO_PINOSC_TA1_TA0_HAL(const struct Sensor *group,uint16_t *counts)
             counts[i] = TA0R;      // Save result
         }
         // Context Restore
-        *((group->arrayPtr[i])->inputPxselRegister) = contextSaveSel;
-        *((group->arrayPtr[i])->inputPxsel2Register) = contextSaveSel2;
+        *ELEMENT_PXSEL(group->arrayPtr[i]) = contextSaveSel;
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) = contextSaveSel2;
     } // End for loop
     // Context Restore
     if(!(contextSaveSR & GIE))
@@ -3128,9 +3442,9 @@ void TI_CTS_fRO_PINOSC_TA1_TA0_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param   counts Pointer to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_fRO_PINOSC_TA1_TB0_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_fRO_PINOSC_TA1_TB0_HAL(const struct Sensor *group,cts_count_t *counts)
 {
-    uint8_t i;
+    uint16_t i;
 
     /*
      *  Context Save
@@ -3170,12 +3484,15 @@ void TI_CTS_fRO_PINOSC_TA1_TB0_HAL(const struct Sensor *group,uint16_t *counts)
 
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA1CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
         // Context Save
-        contextSaveSel = *((group->arrayPtr[i])->inputPxselRegister);
-        contextSaveSel2 = *((group->arrayPtr[i])->inputPxsel2Register);
+        contextSaveSel = *ELEMENT_PXSEL(group->arrayPtr[i]);
+        contextSaveSel2 = *ELEMENT_PXSEL2(group->arrayPtr[i]);
         // Configure Ports for relaxation oscillator
-        *((group->arrayPtr[i])->inputPxselRegister) &= ~((group->arrayPtr[i])->inputBits);
-        *((group->arrayPtr[i])->inputPxsel2Register) |= ((group->arrayPtr[i])->inputBits);
+        *ELEMENT_PXSEL(group->arrayPtr[i]) &= ~((group->arrayPtr[i])->inputBits);
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) |= ((group->arrayPtr[i])->inputBits);
 
         TB0CTL = group->measGateSource + MC_2 + TBCLR;  // continuous mode
     	TB0CTL &= ~TBIFG;
@@ -3209,8 +3526,8 @@ void TI_CTS_fRO_PINOSC_TA1_TB0_HAL(const struct Sensor *group,uint16_t *counts)
             counts[i] = TB0R;      // Save result
         }
         // Context Restore
-        *((group->arrayPtr[i])->inputPxselRegister) = contextSaveSel;
-        *((group->arrayPtr[i])->inputPxsel2Register) = contextSaveSel2;
+        *ELEMENT_PXSEL(group->arrayPtr[i]) = contextSaveSel;
+        *ELEMENT_PXSEL2(group->arrayPtr[i]) = contextSaveSel2;
     } // End for loop
     // Context Restore
     if(!(contextSaveSR & GIE))
@@ -3242,9 +3559,9 @@ void TI_CTS_fRO_PINOSC_TA1_TB0_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param counts pointer to where the measurements are to be written
  *  @return        none
  */
-void TI_CTS_RO_CSIO_TA0_TA1_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_RO_CSIO_TA0_TA1_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
     /*
      *  Allocate Context Save Variables
      *  Status Register: GIE bit only
@@ -3283,6 +3600,9 @@ void TI_CTS_RO_CSIO_TA0_TA1_HAL(const struct Sensor *group,uint16_t *counts)
     TA1CCTL0 = CCIE;
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA1CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
     	/* Enable Capacitive Touch IO oscillation */
 	    *(group->inputCapsioctlRegister)
 	            = ((group->arrayPtr[i])->inputBits)+CAPSIOEN;
@@ -3352,9 +3672,9 @@ void TI_CTS_RO_CSIO_TA0_TA1_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param counts pointer to where the measurements are to be written
  *  @return        none
  */
-void TI_CTS_fRO_CSIO_TA0_TA1_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_fRO_CSIO_TA0_TA1_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
     /*
      *  Allocate Context Save Variables
      *  Status Register: GIE bit only
@@ -3391,6 +3711,9 @@ void TI_CTS_fRO_CSIO_TA0_TA1_HAL(const struct Sensor *group,uint16_t *counts)
     TA0CCTL0 = CCIE;
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA0CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
         /* Enable Capacitive Touch IO oscillation */
         *(group->inputCapsioctlRegister)
 	            = ((group->arrayPtr[i])->inputBits)+CAPSIOEN;
@@ -3462,9 +3785,9 @@ void TI_CTS_fRO_CSIO_TA0_TA1_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param   counts Address to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_fRO_CSIO_TA0_SW_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_fRO_CSIO_TA0_SW_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
     uint16_t j;
 //** Context Save
 //  TIMERA0: TA0CTL, TA0CCR0, TA0CCTL0
@@ -3481,6 +3804,9 @@ void TI_CTS_fRO_CSIO_TA0_SW_HAL(const struct Sensor *group,uint16_t *counts)
 	contextSaveCtl = *(group->inputCapsioctlRegister);
     for (i =0; i< (group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA0CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
         j = 0;
         // Context Save
         // start single oscillation (rise then fall and trigger on fall)
@@ -3524,9 +3850,9 @@ void TI_CTS_fRO_CSIO_TA0_SW_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param counts pointer to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_RO_CSIO_TA0_RTC_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_RO_CSIO_TA0_RTC_HAL(const struct Sensor *group,cts_count_t *counts)
 {
-    uint8_t i;
+    uint16_t i;
     /*
      *  Allocate Context Save Variables
      *  Status Register: GIE bit only
@@ -3564,6 +3890,10 @@ void TI_CTS_RO_CSIO_TA0_RTC_HAL(const struct Sensor *group,uint16_t *counts)
 	    *(group->inputCapsioctlRegister)
 	            = ((group->arrayPtr[i])->inputBits)+CAPSIOEN;
         TA0CTL = TASSEL_3+MC_2+TACLR;
+#ifdef TIMER0A1_OVERFLOW
+        ctsOverflowCount = 0;
+        TA0CTL |= TAIE;         // Count overflows in the high word
+#endif
 //	    TA0CTL |= TACLR;        // Clear Timer_A0 measurement timer
 //	    TA0CTL &= ~TAIFG;       // Clear the overflow flag
         /*
@@ -3574,7 +3904,7 @@ void TI_CTS_RO_CSIO_TA0_RTC_HAL(const struct Sensor *group,uint16_t *counts)
          */
         RTCCTL = RTCSR;
         if(__even_in_range(RTCIV,RTCIV_RTCIF));
-        RTCMOD = group->accumulationCycles;
+        RTCMOD = ACCUMULATION_CYCLES(group, i);
         RTCCTL |= group->measGateSource | RTCSR | group->sourceScale | RTCIE;
         /*
          *  The interrupt handler is defined in RTC_VECTOR, which simply clears
@@ -3591,6 +3921,21 @@ void TI_CTS_RO_CSIO_TA0_RTC_HAL(const struct Sensor *group,uint16_t *counts)
         }
 		
 //		TA0CCTL0 ^= CCIS0;  // Create SW capture of TA0R into TA0CCR0
+#ifdef TIMER0A1_OVERFLOW
+        TA0CTL &= ~(MC_2+TAIE);
+        RTCCTL = RTCSR;
+
+        if(TA0CTL & TAIFG)
+        {
+            /*
+             *  Account for an overflow between the gate interrupt and the
+             *  timer halt; the overflow ISR counts all earlier ones.
+             */
+            TA0CTL &= ~TAIFG;
+            ctsOverflowCount++;
+        }
+        counts[i] = ((uint32_t)ctsOverflowCount << 16) + TA0R;
+#else
         TA0CTL &= ~MC_2;
         RTCCTL = RTCSR;
 		
@@ -3607,6 +3952,7 @@ void TI_CTS_RO_CSIO_TA0_RTC_HAL(const struct Sensor *group,uint16_t *counts)
         {
             counts[i] = TA0R;  // Save result
         }
+#endif
     }  // End For Loop
     /* Context restore GIE within Status Register and registers used. */
     *(group->inputCapsioctlRegister) = contextSaveCtl;
@@ -3648,13 +3994,15 @@ __interrupt void watchdog_timer(void)
 }
 #endif
 
-#ifdef TIMER0A0_GATE
+#if defined(TIMER0A0_GATE) || defined(TIMER0A0_CAPTURE)
 /*!
  *  ======== TIMER0_A0_ISR ========
  *  @ingroup ISR_GROUP
  *  @brief  TIMER0_A0_ISR
  *
  *          This ISR clears the LPM bits found in the Status Register (SR/R2).
+ *          With TIMER0A0_CAPTURE it first takes a software capture of TA1R
+ *          (TA1CCR1), the end of the fRO_PINOSC_TA0_TA1CAP window.
  * 
  *  @param none
  *  @return none
@@ -3662,6 +4010,9 @@ __interrupt void watchdog_timer(void)
 #pragma vector=TIMER0_A0_VECTOR
 __interrupt void TIMER0_A0_ISR(void)
 {
+#ifdef TIMER0A0_CAPTURE
+    TA1CCTL1 ^= CCIS0;                              // SW capture, end of window
+#endif
     __bic_SR_register_on_exit(LPM3_bits);           // Exit LPM3 on reti
 }
 #endif
@@ -3722,6 +4073,75 @@ __interrupt void TIMER3_A0_ISR(void)
 }
 #endif
 
+#ifdef TIMER0A1_OVERFLOW
+/*!
+ *  ======== TIMER0_A1_ISR ========
+ *  @ingroup ISR_GROUP
+ *  @brief  TIMER0_A1_ISR
+ *
+ *          This ISR extends the measurement count of TimerA0 by counting
+ *          overflows in ctsOverflowCount (EXTENDED_COUNTS).
+ *
+ *  @param none
+ *  @return none
+ */
+#pragma vector=TIMER0_A1_VECTOR
+__interrupt void TIMER0_A1_ISR(void)
+{
+    if(TA0CTL & TAIFG)
+    {
+        TA0CTL &= ~TAIFG;
+        ctsOverflowCount++;
+    }
+}
+#endif
+
+#ifdef TIMER1A1_OVERFLOW
+/*!
+ *  ======== TIMER1_A1_ISR ========
+ *  @ingroup ISR_GROUP
+ *  @brief  TIMER1_A1_ISR
+ *
+ *          This ISR extends the measurement count of TimerA1 by counting
+ *          overflows in ctsOverflowCount (EXTENDED_COUNTS).
+ *
+ *  @param none
+ *  @return none
+ */
+#pragma vector=TIMER1_A1_VECTOR
+__interrupt void TIMER1_A1_ISR(void)
+{
+    if(TA1CTL & TAIFG)
+    {
+        TA1CTL &= ~TAIFG;
+        ctsOverflowCount++;
+    }
+}
+#endif
+
+#ifdef TIMER2A1_OVERFLOW
+/*!
+ *  ======== TIMER2_A1_ISR ========
+ *  @ingroup ISR_GROUP
+ *  @brief  TIMER2_A1_ISR
+ *
+ *          This ISR extends the measurement count of TimerA2 by counting
+ *          overflows in ctsOverflowCount (EXTENDED_COUNTS).
+ *
+ *  @param none
+ *  @return none
+ */
+#pragma vector=TIMER2_A1_VECTOR
+__interrupt void TIMER2_A1_ISR(void)
+{
+    if(TA2CTL & TAIFG)
+    {
+        TA2CTL &= ~TAIFG;
+        ctsOverflowCount++;
+    }
+}
+#endif
+
 #ifdef TIMERB0_GATE
 /*!
  *  ======== TIMER0_B0_ISR ========
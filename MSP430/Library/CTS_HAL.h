@@ -81,6 +81,7 @@
  *              - TI_CTS_RO_CSIO_TA0_RTC_HAL()
  *              - TI_CTS_fRO_CSIO_TA0_TA1_HAL()
  *              - TI_CTS_fRO_CSIO_TA0_SW_HAL()
+ *              - TI_CTS_fRO_PINOSC_TA0_TA1CAP_HAL()
 
  *
  */
@@ -90,65 +91,67 @@
 
 #include "structure.h"
 
-void TI_CTS_RO_CSIO_TA0_TA1_HAL(const struct Sensor *,uint16_t *);
+void TI_CTS_RO_CSIO_TA0_TA1_HAL(const struct Sensor *,cts_count_t *);
 
-void TI_CTS_fRO_CSIO_TA0_TA1_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_fRO_CSIO_TA0_TA1_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_fRO_CSIO_TA0_SW_HAL(const struct Sensor *,uint16_t *);
+void TI_CTS_fRO_CSIO_TA0_SW_HAL(const struct Sensor *,cts_count_t *);
 
-void TI_CTS_RO_CSIO_TA0_RTC_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_RO_CSIO_TA0_RTC_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_RO_CSIO_TA0_WDTA_HAL(const struct Sensor *,uint16_t *);
+void TI_CTS_RO_CSIO_TA0_WDTA_HAL(const struct Sensor *,cts_count_t *);
 
-void TI_CTS_RO_CSIO_TA2_WDTA_HAL(const struct Sensor *,uint16_t *);
+void TI_CTS_RO_CSIO_TA2_WDTA_HAL(const struct Sensor *,cts_count_t *);
 
-void TI_CTS_RO_CSIO_TA2_TA3_HAL(const struct Sensor *,uint16_t *);
+void TI_CTS_RO_CSIO_TA2_TA3_HAL(const struct Sensor *,cts_count_t *);
 
-void TI_CTS_fRO_CSIO_TA2_TA3_HAL(const struct Sensor *,uint16_t *);
+void TI_CTS_fRO_CSIO_TA2_TA3_HAL(const struct Sensor *,cts_count_t *);
 
-void TI_CTS_RO_COMPB_TB0_WDTA_HAL(const struct Sensor *,uint16_t *);
+void TI_CTS_RO_COMPB_TB0_WDTA_HAL(const struct Sensor *,cts_count_t *);
 
-void TI_CTS_RO_PINOSC_TA0_TA1_HAL(const struct Sensor *,uint16_t *);
+void TI_CTS_RO_PINOSC_TA0_TA1_HAL(const struct Sensor *,cts_count_t *);
 
-void TI_CTS_fRO_PINOSC_TA0_TA1_HAL(const struct Sensor *,uint16_t *);
+void TI_CTS_fRO_PINOSC_TA0_TA1_HAL(const struct Sensor *,cts_count_t *);
 
-void TI_CTS_RO_COMPAp_TA0_WDTp_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_RO_COMPAp_TA0_WDTp_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_fRO_COMPAp_TA0_SW_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_fRO_COMPAp_TA0_SW_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_fRO_COMPAp_SW_TA0_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_fRO_COMPAp_SW_TA0_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_RO_COMPAp_TA1_WDTp_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_RO_COMPAp_TA1_WDTp_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_fRO_COMPAp_TA1_SW_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_fRO_COMPAp_TA1_SW_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_RC_PAIR_TA0_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_RC_PAIR_TA0_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_RO_PINOSC_TA0_WDTp_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_RO_PINOSC_TA0_WDTp_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_RO_PINOSC_TA0_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_RO_PINOSC_TA0_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_fRO_PINOSC_TA0_SW_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_fRO_PINOSC_TA0_SW_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_RO_COMPB_TA0_WDTA_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_fRO_PINOSC_TA0_TA1CAP_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_fRO_COMPB_TA0_SW_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_RO_COMPB_TA0_WDTA_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_RO_COMPB_TA1_WDTA_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_fRO_COMPB_TA0_SW_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_fRO_COMPB_TA1_SW_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_RO_COMPB_TA1_WDTA_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_RO_COMPB_TA1_TA0_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_fRO_COMPB_TA1_SW_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_fRO_COMPB_TA1_TA0_HAL(const struct Sensor *,uint16_t *);
+void TI_CTS_RO_COMPB_TA1_TA0_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_RO_PINOSC_TA1_WDTp_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_fRO_COMPB_TA1_TA0_HAL(const struct Sensor *,cts_count_t *);
 
-void TI_CTS_RO_PINOSC_TA1_TB0_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_RO_PINOSC_TA1_WDTp_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_fRO_PINOSC_TA1_TA0_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_RO_PINOSC_TA1_TB0_HAL(const struct Sensor *, cts_count_t *);
 
-void TI_CTS_fRO_PINOSC_TA1_TB0_HAL(const struct Sensor *, uint16_t *);
+void TI_CTS_fRO_PINOSC_TA1_TA0_HAL(const struct Sensor *, cts_count_t *);
+
+void TI_CTS_fRO_PINOSC_TA1_TB0_HAL(const struct Sensor *, cts_count_t *);
 
 
 #endif /* CTS_HAL_H_ */
@@ -60,10 +60,48 @@
  *              - TI_CAPT_Buttons()
  *              - TI_CAPT_Slider()
  *              - TI_CAPT_Wheel()
+ *              - TI_CAPT_Matrix()
+ *              - TI_CAPT_Touchpad()
+ *              - TI_CAPT_Tracked_Slider()
+ *              - TI_CAPT_Tracked_Wheel()
+ *              - TI_CAPT_Calibrate_Position_Lut()
+ *              - TI_CAPT_Calibrate_Wheel_Lut()
+ *              - TI_CAPT_Roi_Buttons()
+ *              - TI_CAPT_Roi_Slider()
+ *              - TI_CAPT_Roi_Wheel()
+ *              - TI_CAPT_Register_Callbacks()
+ *              - TI_CAPT_Recover_Baseline()
  */
 
 #include "CTS_Layer.h"
 
+/*
+ *  Release threshold of element e, 0 when the element has none.  With
+ *  ELEMENT_HYSTERESIS a touched element stays touched until its delta falls
+ *  below releaseThreshold instead of threshold.
+ */
+#ifdef ELEMENT_HYSTERESIS
+#define RELEASE_THRESHOLD(e)  ((e)->releaseThreshold)
+#define ELEMENT_TOUCHED(i)    (ctsTouched[(i) >> 3] & (1 << ((i) & 7)))
+#else
+#define RELEASE_THRESHOLD(e)  0
+#endif
+
+/*
+ *  Threshold that element i of sensor s must reach to count as touched:
+ *  the release threshold while the element is touched, if it has one.
+ *  Only for deciding touched or not; positions and percentages are always
+ *  relative to threshold.
+ */
+#ifdef ELEMENT_HYSTERESIS
+#define TOUCH_THRESHOLD(s, i) \
+    ((RELEASE_THRESHOLD((s)->arrayPtr[i]) \
+      && ELEMENT_TOUCHED((s)->baseOffset + (i))) \
+     ? RELEASE_THRESHOLD((s)->arrayPtr[i]) : ((s)->arrayPtr[i])->threshold)
+#else
+#define TOUCH_THRESHOLD(s, i) (((s)->arrayPtr[i])->threshold)
+#endif
+
 /*! @defgroup GLOBAL_VARS Global Variables
  *  @{ 
  */
@@ -71,18 +109,47 @@
 /*! 
  *  The baseline tracking variables 
  */
-uint16_t baseCnt[TOTAL_NUMBER_OF_ELEMENTS];
+cts_count_t baseCnt[TOTAL_NUMBER_OF_ELEMENTS];
 #ifdef RAM_FOR_FLASH
 /*! 
  *  The current measurement variables
  */
-uint16_t measCnt[MAXIMUM_NUMBER_OF_ELEMENTS_PER_SENSOR];
+cts_count_t measCnt[MAXIMUM_NUMBER_OF_ELEMENTS_PER_SENSOR];
 #endif
 /*! 
  *  The Status Register
  */
 uint16_t ctsStatusReg = (DOI_INC+TRADOI_FAST+TRIDOI_SLOW);
 #endif
+#ifdef ROI_SCAN
+/*!
+ *  Region of interest state of the sensor being scanned by a TI_CAPT_Roi_xxx
+ *  call, 0 otherwise
+ */
+static struct RoiState *ctsRoi;
+#endif
+#ifdef SENSOR_CALLBACKS
+/*!
+ *  Callbacks registered with TI_CAPT_Register_Callbacks()
+ */
+static struct SensorCallbacks *ctsCallbacks[CALLBACK_SENSORS];
+#endif
+#ifdef STUCK_TOUCH_RECOVERY
+/*!
+ *  Consecutive scans each element has been above its threshold
+ */
+static uint16_t ctsOnScans[TOTAL_NUMBER_OF_ELEMENTS];
+/*!
+ *  Remaining baseline recovery scans of each element
+ */
+static uint8_t ctsRecoveryScans[TOTAL_NUMBER_OF_ELEMENTS];
+#endif
+#ifdef ELEMENT_HYSTERESIS
+/*!
+ *  Touch state of each element, one bit per element indexed like baseCnt
+ */
+static uint8_t ctsTouched[(TOTAL_NUMBER_OF_ELEMENTS+7)/8];
+#endif
 /*!
  *  @}
  */
@@ -105,7 +172,7 @@ uint16_t ctsStatusReg = (DOI_INC+TRADOI_FAST+TRIDOI_SLOW);
  * @param   counts Address to where the measurements are to be written
  * @return  none
  ******************************************************************************/
-void TI_CAPT_Raw(const struct Sensor* groupOfElements, uint16_t * counts)
+void TI_CAPT_Raw(const struct Sensor* groupOfElements, cts_count_t * counts)
 {
 #ifdef RO_CSIO_TA2_WDTA
     if(groupOfElements->halDefinition == RO_CSIO_TA2_WDTA)
@@ -255,6 +322,13 @@ void TI_CAPT_Raw(const struct Sensor* groupOfElements, uint16_t * counts)
     }
 #endif
 
+#ifdef fRO_PINOSC_TA0_TA1CAP
+    if(groupOfElements->halDefinition == fRO_PINOSC_TA0_TA1CAP)
+    {
+        TI_CTS_fRO_PINOSC_TA0_TA1CAP_HAL(groupOfElements, counts);
+    }
+#endif
+
 #ifdef RO_COMPB_TA0_WDTA
     if(groupOfElements->halDefinition == RO_COMPB_TA0_WDTA)
     {
@@ -334,6 +408,16 @@ void TI_CAPT_Raw(const struct Sensor* groupOfElements, uint16_t * counts)
  ******************************************************************************/
 void TI_CAPT_Init_Baseline(const struct Sensor* groupOfElements)
 {
+#ifdef STUCK_TOUCH_RECOVERY
+    uint16_t i;
+
+    for(i = groupOfElements->baseOffset;
+        i < groupOfElements->baseOffset + groupOfElements->numElements; i++)
+    {
+        ctsOnScans[i] = 0;
+        ctsRecoveryScans[i] = 0;
+    }
+#endif
     TI_CAPT_Raw(groupOfElements, &baseCnt[groupOfElements->baseOffset]);
 }
 
@@ -345,10 +429,10 @@ void TI_CAPT_Init_Baseline(const struct Sensor* groupOfElements)
  ******************************************************************************/
 void TI_CAPT_Update_Baseline(const struct Sensor* groupOfElements, uint8_t numberOfAverages)
 {
-	uint8_t i,j;
+	uint16_t i,j;
     #ifndef RAM_FOR_FLASH
-	uint16_t *measCnt;
-    measCnt = (uint16_t *)malloc(groupOfElements->numElements * sizeof(uint16_t));
+	cts_count_t *measCnt;
+    measCnt = (cts_count_t *)malloc(groupOfElements->numElements * sizeof(cts_count_t));
     if(measCnt ==0)
     {
         while(1);
@@ -356,9 +440,9 @@ void TI_CAPT_Update_Baseline(const struct Sensor* groupOfElements, uint8_t numbe
     #endif
     for(j=0; j < numberOfAverages; j++)
     {
+        TI_CAPT_Raw(groupOfElements, measCnt);
         for(i=0; i < groupOfElements->numElements; i++)
         {
-            TI_CAPT_Raw(groupOfElements, measCnt);
             baseCnt[i+groupOfElements->baseOffset]
                     = measCnt[i]/2 + baseCnt[i+groupOfElements->baseOffset]/2;
         }
@@ -406,191 +490,262 @@ void TI_CAPT_Update_Tracking_Rate(uint8_t rate)
     ctsStatusReg |= (rate & 0xF0); // update fields
 }
 
+#ifdef ROI_SCAN
 /***************************************************************************//**
- * @brief   Measure the change in capacitance of the Sensor
- * 
- *          This function measures the change in capacitance of each element
- *          within a sensor and updates the baseline tracking in the event that
- *          no change exceeds the detection threshold.
- *          The order of the elements within the Sensor structure is arbitrary 
- *          but must be consistent between the application and configuration. 
- *          The first element in the array (deltaCnt) corresponds to the first 
- *          element within the Sensor structure.
+ * @brief   Measure the region of interest of a sensor
+ *
+ *          During a region scan only the ROI_RADIUS elements on each side of
+ *          the last dominant element are measured, wrapping around like a
+ *          wheel.  The counts of the other elements are set to 0, which
+ *          TI_CAPT_Custom treats as 'no measurement' (no delta, no baseline
+ *          update).  Otherwise all elements are measured.
  * @param   groupOfElements Pointer to Sensor structure to be measured
- * @param   deltaCnt Address to where the measurements are to be written
+ * @param   counts Address to where the measurements are to be written
  * @return  none
  ******************************************************************************/
-void TI_CAPT_Custom(const struct Sensor* groupOfElements, uint16_t * deltaCnt)
-{ 
-    uint8_t j;
-    uint16_t tempCnt, remainder;
-    ctsStatusReg &= ~ EVNT;
-	
-    TI_CAPT_Raw(groupOfElements, &deltaCnt[0]); // measure group of sensors
-          
-    for (j = 0; j < (groupOfElements->numElements); j++)
-    {  
-        tempCnt = deltaCnt[j];
-        if(deltaCnt[j])
-        {
-        if(((ctsStatusReg & DOI_MASK)
-        		&& (groupOfElements->halDefinition & RO_MASK))
-            ||
-         ((!(ctsStatusReg & DOI_MASK))
-        		&& (!(groupOfElements->halDefinition & RO_MASK))))
-        { 
-        	/*
-        	 * Interested in a decrease in counts. Either the decrease
-        	 * represents an increase in capacitance (a touch) with the
-        	 * RO method, or the decrease represents a decrease in capacitance
-        	 * (release) with the fRO or RC methods.
-        	 */
-            if(baseCnt[j+groupOfElements->baseOffset] < deltaCnt[j])            
-            {
-                /*
-                 * The measured value is greater than the baseline therefore
-                 * no detection logic is needed.  The measured value is
-                 * preserved in tempCnt and is used for baseline updates.
-                 */
-                deltaCnt[j] = 0;
-                if(((groupOfElements->arrayPtr[j])->threshold)
-                &&
-                (baseCnt[j+groupOfElements->baseOffset]
-                    +((groupOfElements->arrayPtr[j])->threshold/2) < tempCnt))
-                {
-                	/*
-                	 * When the threshold is valid (non-calibration state),
-                	 * limit the measurement to the baseline + threshold/2.
-                	 */
-                    tempCnt = baseCnt[j+groupOfElements->baseOffset]
-                                +((groupOfElements->arrayPtr[j])->threshold)/2;
-                }
-            }
-            else
+static void Roi_Raw(const struct Sensor* groupOfElements, cts_count_t* counts)
+{
+    struct Sensor roiSensor;
+#ifdef FLEXIBLE_ELEMENT_ARRAY
+    struct Element const *roiElements[2*ROI_RADIUS+1];
+#endif
+    cts_count_t roiCnt[2*ROI_RADIUS+1];
+    uint16_t index[2*ROI_RADIUS+1];
+    uint16_t i;
+    uint16_t n = groupOfElements->numElements;
+
+    if(!(ctsRoi && ctsRoi->partial) || (n <= 2*ROI_RADIUS+1))
+    {
+        TI_CAPT_Raw(groupOfElements, counts);
+        return;
+    }
+    roiSensor = *groupOfElements;
+    roiSensor.numElements = 2*ROI_RADIUS+1;
+    for(i=0; i < 2*ROI_RADIUS+1; i++)
+    {
+        index[i] = (ctsRoi->center + n - ROI_RADIUS + i) % n;
+#ifdef FLEXIBLE_ELEMENT_ARRAY
+        roiElements[i] = groupOfElements->arrayPtr[index[i]];
+#else
+        roiSensor.arrayPtr[i] = groupOfElements->arrayPtr[index[i]];
+#endif
+    }
+#ifdef FLEXIBLE_ELEMENT_ARRAY
+    roiSensor.arrayPtr = roiElements;
+#endif
+    TI_CAPT_Raw(&roiSensor, roiCnt);
+    for(i=0; i < n; i++)
+    {
+        counts[i] = 0;
+    }
+    for(i=0; i < 2*ROI_RADIUS+1; i++)
+    {
+        counts[index[i]] = roiCnt[i];
+    }
+}
+#endif
+
+/***************************************************************************//**
+ * @brief   Process the measurement of one element
+ *
+ *          Converts the measurement of a single element into a delta relative
+ *          to its baseline, updates the baseline tracking and flags an event
+ *          when the delta exceeds the threshold.  TI_CAPT_Custom() calls this
+ *          for each element.
+ * @param   halDefinition Measurement method of the sensor
+ * @param   threshold Detection threshold of the element
+ * @param   releaseThreshold Threshold that ends a touch, 0: threshold
+ * @param   deltaCnt Address of the measurement, replaced with the delta
+ * @param   base Address of the element baseline
+ * @return  none
+ ******************************************************************************/
+static inline void Custom_Element(uint8_t halDefinition, uint16_t threshold,
+                                  uint16_t releaseThreshold,
+                                  cts_count_t *deltaCnt, cts_count_t *base)
+{
+    cts_count_t tempCnt;
+    uint16_t remainder;
+#if defined(STUCK_TOUCH_RECOVERY) || defined(ELEMENT_HYSTERESIS)
+    uint16_t element = base - baseCnt;
+#endif
+
+#ifdef ELEMENT_HYSTERESIS
+    if(releaseThreshold && ELEMENT_TOUCHED(element))
+    {
+        threshold = releaseThreshold; // touched: hold until below release
+    }
+#endif
+#ifdef STUCK_TOUCH_RECOVERY
+    if(ctsRecoveryScans[element] && *deltaCnt)
+    {
+        /*
+         * Recovering from a stuck touch: move the baseline halfway to the
+         * measurement each scan and onto it with the last recovery scan.
+         * The element reports no change meanwhile.
+         */
+        ctsRecoveryScans[element]--;
+        if(ctsRecoveryScans[element])
+        {
+            *base = *base/2 + *deltaCnt/2;
+        }
+        else
+        {
+            *base = *deltaCnt;
+        }
+        *deltaCnt = 0;
+#ifdef ELEMENT_HYSTERESIS
+        ctsTouched[element >> 3] &= ~(1 << (element & 7));
+#endif
+        return;
+    }
+#endif
+
+    tempCnt = *deltaCnt;
+    if(*deltaCnt)
+    {
+    if(((ctsStatusReg & DOI_MASK)
+    		&& (halDefinition & RO_MASK))
+        ||
+     ((!(ctsStatusReg & DOI_MASK))
+    		&& (!(halDefinition & RO_MASK))))
+    { 
+    	/*
+    	 * Interested in a decrease in counts. Either the decrease
+    	 * represents an increase in capacitance (a touch) with the
+    	 * RO method, or the decrease represents a decrease in capacitance
+    	 * (release) with the fRO or RC methods.
+    	 */
+        if(*base < *deltaCnt)            
+        {
+            /*
+             * The measured value is greater than the baseline therefore
+             * no detection logic is needed.  The measured value is
+             * preserved in tempCnt and is used for baseline updates.
+             */
+            *deltaCnt = 0;
+            if(threshold && (*base + threshold/2 < tempCnt))
             {
-                /*
-                 * deltaCnt now represents the magnitude of change relative to
-                 * the baseline.
-                 */
-                deltaCnt[j] = baseCnt[j+groupOfElements->baseOffset]
-                                  - deltaCnt[j];
+            	/*
+            	 * When the threshold is valid (non-calibration state),
+            	 * limit the measurement to the baseline + threshold/2.
+            	 */
+                tempCnt = *base + threshold/2;
             }
         }
-        if(((!(ctsStatusReg & DOI_MASK))
-        		&& (groupOfElements->halDefinition & RO_MASK))
-           ||
-             ((ctsStatusReg & DOI_MASK)
-            	&& (!(groupOfElements->halDefinition & RO_MASK))))
-        { 
-        	/*
-        	 * Interested in an increase in counts. Either the increase
-        	 * represents a decrease in capacitance (a release) with the
-        	 * RO method, or the increase represents a increase in capacitance
-        	 * (touch) with the fRO or RC methods.
-        	 */
-            if(baseCnt[j+groupOfElements->baseOffset] > deltaCnt[j])            
+        else
+        {
+            /*
+             * deltaCnt now represents the magnitude of change relative to
+             * the baseline.
+             */
+            *deltaCnt = *base - *deltaCnt;
+        }
+    }
+    if(((!(ctsStatusReg & DOI_MASK))
+    		&& (halDefinition & RO_MASK))
+       ||
+         ((ctsStatusReg & DOI_MASK)
+        	&& (!(halDefinition & RO_MASK))))
+    { 
+    	/*
+    	 * Interested in an increase in counts. Either the increase
+    	 * represents a decrease in capacitance (a release) with the
+    	 * RO method, or the increase represents a increase in capacitance
+    	 * (touch) with the fRO or RC methods.
+    	 */
+        if(*base > *deltaCnt)            
+        {
+            /*
+             * The measured value is less than the baseline therefore
+             * no detection logic is needed.  The measured value is
+             * preserved in tempCnt and is used for baseline updates.
+             */
+            *deltaCnt = 0;
+            if(threshold && (*base - threshold/2 > tempCnt))
             {
-                /*
-                 * The measured value is less than the baseline therefore
-                 * no detection logic is needed.  The measured value is
-                 * preserved in tempCnt and is used for baseline updates.
-                 */
-                deltaCnt[j] = 0;
-                if(((groupOfElements->arrayPtr[j])->threshold)
-                &&
-                (baseCnt[j+groupOfElements->baseOffset]
-                     -((groupOfElements->arrayPtr[j])->threshold/2) > tempCnt))
-                {
-                	/*
-                	 * When the threshold is valid (non-calibration state),
-                	 * limit the measurement to the baseline - threshold/2.
-                	 */
-                    tempCnt = baseCnt[j+groupOfElements->baseOffset]
-                                -((groupOfElements->arrayPtr[j])->threshold)/2;
-                }
+            	/*
+            	 * When the threshold is valid (non-calibration state),
+            	 * limit the measurement to the baseline - threshold/2.
+            	 */
+                tempCnt = *base - threshold/2;
             }
-            else       
-            {
-                /*
-                 * deltaCnt now represents the magnitude of change relative to
-                 * the baseline.
-                 */
-                deltaCnt[j] = deltaCnt[j]
-                              - baseCnt[j+groupOfElements->baseOffset];
-            }         
-        }
-            
-        // This section updates the baseline capacitance************************
-        if (deltaCnt[j]==0)
-        { // if delta counts is 0, then the change in capacitance was opposite
-          // the direction of interest.  The baseCnt[i] is updated with the
-          // saved tempCnt value for the current index value 'i'.
-        	remainder = 0;
+        }
+        else       
+        {
+            /*
+             * deltaCnt now represents the magnitude of change relative to
+             * the baseline.
+             */
+            *deltaCnt = *deltaCnt - *base;
+        }         
+    }
+        
+    // This section updates the baseline capacitance************************
+    if (*deltaCnt==0)
+    { // if delta counts is 0, then the change in capacitance was opposite
+      // the direction of interest.  The baseCnt[i] is updated with the
+      // saved tempCnt value for the current index value 'i'.
+    	remainder = 0;
 			switch ((ctsStatusReg & TRADOI_VSLOW))
 			{
 			case TRADOI_FAST://Fast
 					tempCnt = tempCnt/2;
-					baseCnt[j+groupOfElements->baseOffset]
-					= (baseCnt[j+groupOfElements->baseOffset]/2);
+					*base = (*base/2);
 					break;
 			case TRADOI_MED://Medium
 					tempCnt = tempCnt/4;
-					baseCnt[j+groupOfElements->baseOffset]
-					= 3*(baseCnt[j+groupOfElements->baseOffset]/4);
+					*base = 3*(*base/4);
 					break;
 			case TRADOI_SLOW://slow
 				  /* Calculate remainder associated with (x + 63*y)/64 */
-				  remainder = 0x003F & baseCnt[j+groupOfElements->baseOffset];
+				  remainder = 0x003F & *base;
 				  remainder = remainder * 63;
 				  remainder += 0x003F & tempCnt;           
 				  remainder = remainder >> 6;
 				  tempCnt = tempCnt/64;
-				  baseCnt[j+groupOfElements->baseOffset]
-				  = 63*(baseCnt[j+groupOfElements->baseOffset]/64);
+				  *base = 63*(*base/64);
 					break;
 			case TRADOI_VSLOW://very slow
-                /* Calculate remainder associated with (x+127*y)/128 */
-                remainder = 0x007F & baseCnt[j+groupOfElements->baseOffset];
-                remainder = remainder * 127;
-                remainder += 0x007F & tempCnt;
-                remainder = remainder >> 7;
+            /* Calculate remainder associated with (x+127*y)/128 */
+            remainder = 0x007F & *base;
+            remainder = remainder * 127;
+            remainder += 0x007F & tempCnt;
+            remainder = remainder >> 7;
 				tempCnt = tempCnt/128;
-				baseCnt[j+groupOfElements->baseOffset]
-				= 127*(baseCnt[j+groupOfElements->baseOffset]/128);
+				*base = 127*(*base/128);
 			break;
 			}
-            /* Base_Capacitance = (Measured_Capacitance/Z)
+        /* Base_Capacitance = (Measured_Capacitance/Z)
 		                        + Y*(Base_Capacitance/Z) */
 		    tempCnt += remainder;
-            baseCnt[j+groupOfElements->baseOffset] += tempCnt;
-            /* In the case that DOI is set and */
-            if(groupOfElements->halDefinition & RO_MASK)
-            {
+        *base += tempCnt;
+        /* In the case that DOI is set and */
+        if(halDefinition & RO_MASK)
+        {
 			    /*  If the RO_MASK is set then the direction of interest is
 			     *  decreasing (counts decrease with capacitance) and therefore
 			     *  movement against the direction of interest would be an
 			     *  increase: increment.
 			     */
-                baseCnt[j+groupOfElements->baseOffset]++;
-            }
-            else
-            {
+            (*base)++;
+        }
+        else
+        {
 			    /*  RO_MASK is not set and therefore a decrease is against
 			     *  the direction of interest: decrement
 			     */
-                baseCnt[j+groupOfElements->baseOffset]--;
-            }
+            (*base)--;
         }
-        /* deltaCnt is either 0, less than threshold, or greater than 
+    }
+    /* deltaCnt is either 0, less than threshold, or greater than 
 		   threshold, never negative. */
-        else if(deltaCnt[j]<(groupOfElements->arrayPtr[j])->threshold 
-		         && !(ctsStatusReg & PAST_EVNT))
-        {    //if delta counts is positive but less than threshold,
-        	remainder = 1;
-            switch ((ctsStatusReg & TRIDOI_FAST))
-            {
-            case TRIDOI_VSLOW:
-                tempCnt = 0;
+    else if(*deltaCnt<threshold && !(ctsStatusReg & PAST_EVNT))
+    {    //if delta counts is positive but less than threshold,
+    	remainder = 1;
+        switch ((ctsStatusReg & TRIDOI_FAST))
+        {
+        case TRIDOI_VSLOW:
+            tempCnt = 0;
 				break;
 			case TRIDOI_SLOW://slow
 				remainder = 2;
@@ -598,48 +753,173 @@ void TI_CAPT_Custom(const struct Sensor* groupOfElements, uint16_t * deltaCnt)
 			    break;
 			case TRIDOI_MED://medium
 				tempCnt = tempCnt/4;
-				baseCnt[j+groupOfElements->baseOffset] = 3*(baseCnt[j+groupOfElements->baseOffset]/4);
+				*base = 3*(*base/4);
 				break;
 			case TRIDOI_FAST://fast
 				tempCnt = tempCnt/2;
-				baseCnt[j+groupOfElements->baseOffset] = (baseCnt[j+groupOfElements->baseOffset]/2);
+				*base = (*base/2);
 				break;
 			}
-          /*
-           *  Base_Capacitance = (Measured_Capacitance/Z) +
-           *  Y*(Base_Capacitance/Z)
-           */
-          baseCnt[j+groupOfElements->baseOffset] += tempCnt;
-          if(groupOfElements->halDefinition & RO_MASK)
-          {
+      /*
+       *  Base_Capacitance = (Measured_Capacitance/Z) +
+       *  Y*(Base_Capacitance/Z)
+       */
+      *base += tempCnt;
+      if(halDefinition & RO_MASK)
+      {
 			    /*  If the RO_MASK is set then the direction of interest is
 			     *  decreasing (counts decrease with capacitance) and
 			     *  therefore movement in the direction of interest would
 			     *  be a decrease: decrement.
 			     */
-              baseCnt[j+groupOfElements->baseOffset]-= remainder;
-          }
-          else
-          {
+          *base-= remainder;
+      }
+      else
+      {
 			    /*  RO_MASK is not set and therefore an increase is in the
 			     *  direction of interest: increment
 			     */
-              baseCnt[j+groupOfElements->baseOffset]+= remainder;
-          }
+          *base+= remainder;
+      }
+    }
+    //if delta counts above the threshold, event has occurred
+    else if(*deltaCnt>=threshold)
+    {
+      ctsStatusReg |= EVNT;
+      ctsStatusReg |= PAST_EVNT;
+    }
+#ifdef STUCK_TOUCH_RECOVERY
+    if(!threshold || (*deltaCnt < threshold))
+    {
+        ctsOnScans[element] = 0;
+    }
+    else if(++ctsOnScans[element] >= STUCK_TOUCH_SCANS)
+    {
+        // touched for too long: re-baseline over the next scans
+        ctsOnScans[element] = 0;
+        ctsRecoveryScans[element] = RECOVERY_SCANS;
+    }
+#endif
+#ifdef ELEMENT_HYSTERESIS
+    if(threshold && (*deltaCnt >= threshold))
+    {
+        ctsTouched[element >> 3] |= (1 << (element & 7));
+    }
+    else
+    {
+        ctsTouched[element >> 3] &= ~(1 << (element & 7));
+    }
+#endif
+    }
+}
+
+/***************************************************************************//**
+ * @brief   Measure the change in capacitance of the Sensor
+ * 
+ *          This function measures the change in capacitance of each element
+ *          within a sensor and updates the baseline tracking in the event that
+ *          no change exceeds the detection threshold.
+ *          The order of the elements within the Sensor structure is arbitrary 
+ *          but must be consistent between the application and configuration. 
+ *          The first element in the array (deltaCnt) corresponds to the first 
+ *          element within the Sensor structure.
+ * @param   groupOfElements Pointer to Sensor structure to be measured
+ * @param   deltaCnt Address to where the measurements are to be written
+ * @return  none
+ ******************************************************************************/
+void TI_CAPT_Custom(const struct Sensor* groupOfElements, cts_count_t * deltaCnt)
+{ 
+    uint16_t j;
+
+    ctsStatusReg &= ~ EVNT;
+	
+#ifdef ROI_SCAN
+    Roi_Raw(groupOfElements, &deltaCnt[0]); // measure region of interest
+#else
+    TI_CAPT_Raw(groupOfElements, &deltaCnt[0]); // measure group of sensors
+#endif
+          
+    for (j = 0; j < (groupOfElements->numElements); j++)
+    {  
+        Custom_Element(groupOfElements->halDefinition,
+                       (groupOfElements->arrayPtr[j])->threshold,
+                       RELEASE_THRESHOLD(groupOfElements->arrayPtr[j]),
+                       &deltaCnt[j], &baseCnt[j+groupOfElements->baseOffset]);
+    }// end of for-loop
+    if(!(ctsStatusReg & EVNT))
+    {
+      ctsStatusReg &= ~PAST_EVNT;
+    }
+}
+
+#ifdef SENSOR_CALLBACKS
+/***************************************************************************//**
+ * @brief   Call the registered callbacks of a sensor if its state changed
+ *
+ *          Buttons report the index of the pressed element, sliders and
+ *          wheels the position.  A change of the pressed button is reported
+ *          as the release of the old and the press of the new button, a
+ *          change of position while touched as a position change.
+ * @param   groupOfElements Pointer to the scanned sensor
+ * @param   touched Indication if the sensor is (1) or is not (0) touched
+ * @param   value Element index or position, valid when touched
+ * @param   positional 1 for sliders and wheels, 0 for buttons
+ * @return  none
+ ******************************************************************************/
+static void Callback_Dispatch(const struct Sensor* groupOfElements,
+                              uint8_t touched, uint16_t value,
+                              uint8_t positional)
+{
+    struct SensorCallbacks *callbacks = 0;
+    uint16_t previous;
+    uint8_t i;
+
+    for(i = 0; i < CALLBACK_SENSORS; i++)
+    {
+        if(ctsCallbacks[i] && (ctsCallbacks[i]->sensor == groupOfElements))
+        {
+            callbacks = ctsCallbacks[i];
+            break;
         }
-        //if delta counts above the threshold, event has occurred
-        else if(deltaCnt[j]>=(groupOfElements->arrayPtr[j])->threshold)
+    }
+    if(!callbacks || ((touched == callbacks->touched)
+                      && (!touched || (value == callbacks->value))))
+    {
+        return; // nothing registered or nothing changed
+    }
+    previous = callbacks->value;
+    if(callbacks->touched && (!touched || !positional))
+    {
+        if(callbacks->release)
         {
-          ctsStatusReg |= EVNT;
-          ctsStatusReg |= PAST_EVNT;
+            callbacks->release(groupOfElements, previous);
         }
+        if(!positional && callbacks->elementRelease
+           && callbacks->elementRelease[previous])
+        {
+            callbacks->elementRelease[previous]();
         }
-    }// end of for-loop
-    if(!(ctsStatusReg & EVNT))
+    }
+    if(touched && (!callbacks->touched || !positional))
     {
-      ctsStatusReg &= ~PAST_EVNT;
+        if(callbacks->press)
+        {
+            callbacks->press(groupOfElements, value);
+        }
+        if(!positional && callbacks->elementPress
+           && callbacks->elementPress[value])
+        {
+            callbacks->elementPress[value]();
+        }
     }
+    else if(touched && callbacks->positionChange)
+    {
+        callbacks->positionChange(groupOfElements, value);
+    }
+    callbacks->touched = touched;
+    callbacks->value = value;
 }
+#endif
 
 /***************************************************************************//**
  * @brief   Determine if a button is being pressed
@@ -651,8 +931,8 @@ uint8_t TI_CAPT_Button(const struct Sensor * groupOfElements)
     uint8_t result = 0;
     
     #ifndef RAM_FOR_FLASH
-    uint16_t *measCnt;
-    measCnt = (uint16_t *)malloc(groupOfElements->numElements * sizeof(uint16_t));
+    cts_count_t *measCnt;
+    measCnt = (cts_count_t *)malloc(groupOfElements->numElements * sizeof(cts_count_t));
     if(measCnt ==0)
     {
         while(1);
@@ -677,10 +957,10 @@ uint8_t TI_CAPT_Button(const struct Sensor * groupOfElements)
  ******************************************************************************/
 const struct Element *TI_CAPT_Buttons(const struct Sensor *groupOfElements)
 {
-    uint8_t index;
+    uint16_t index;
     #ifndef RAM_FOR_FLASH
-    uint16_t *measCnt;
-    measCnt = (uint16_t *)malloc(groupOfElements->numElements * sizeof(uint16_t));
+    cts_count_t *measCnt;
+    measCnt = (cts_count_t *)malloc(groupOfElements->numElements * sizeof(cts_count_t));
     if(measCnt ==0)
     {
         while(1);
@@ -701,6 +981,9 @@ const struct Element *TI_CAPT_Buttons(const struct Sensor *groupOfElements)
     #ifndef RAM_FOR_FLASH
     free(measCnt);
     #endif
+#ifdef SENSOR_CALLBACKS
+    Callback_Dispatch(groupOfElements, (index != 0), index-1, 0);
+#endif
     if(index)
     {
       return groupOfElements->arrayPtr[index-1];
@@ -716,12 +999,12 @@ const struct Element *TI_CAPT_Buttons(const struct Sensor *groupOfElements)
  ******************************************************************************/
 uint16_t TI_CAPT_Slider(const struct Sensor* groupOfElements)
 {
-    uint8_t index;
+    uint16_t index;
     int16_t position;
     // allocate memory for measurement
     #ifndef RAM_FOR_FLASH
-    uint16_t *measCnt;
-    measCnt = (uint16_t *)malloc(groupOfElements->numElements * sizeof(uint16_t));
+    cts_count_t *measCnt;
+    measCnt = (cts_count_t *)malloc(groupOfElements->numElements * sizeof(cts_count_t));
     if(measCnt ==0)
     {
         while(1);
@@ -816,9 +1099,19 @@ uint16_t TI_CAPT_Slider(const struct Sensor* groupOfElements)
             position = ILLEGAL_SLIDER_WHEEL_POSITION;
         }
     }
+#ifdef SLIDER_LUT
+    if((position >= 0) && groupOfElements->positionLut)
+    {
+        // linearize with the calibrated correction table
+        position = groupOfElements->positionLut[position];
+    }
+#endif
     #ifndef RAM_FOR_FLASH
     free(measCnt);
     #endif
+#ifdef SENSOR_CALLBACKS
+    Callback_Dispatch(groupOfElements, (position >= 0), position, 1);
+#endif
     return position;
 }
 #endif
@@ -831,12 +1124,12 @@ uint16_t TI_CAPT_Slider(const struct Sensor* groupOfElements)
  ******************************************************************************/
 uint16_t TI_CAPT_Wheel(const struct Sensor* groupOfElements)
 {
-    uint8_t index;
+    uint16_t index;
     int16_t position;
     // allocate memory for measurement
     #ifndef RAM_FOR_FLASH
-    uint16_t *measCnt;
-    measCnt = (uint16_t *)malloc(groupOfElements->numElements * sizeof(uint16_t));
+    cts_count_t *measCnt;
+    measCnt = (cts_count_t *)malloc(groupOfElements->numElements * sizeof(cts_count_t));
     if(measCnt ==0)
     {
         while(1);
@@ -940,13 +1233,640 @@ uint16_t TI_CAPT_Wheel(const struct Sensor* groupOfElements)
             position = ILLEGAL_SLIDER_WHEEL_POSITION;
         }
     }
+#ifdef SLIDER_LUT
+    if((position >= 0) && groupOfElements->positionLut)
+    {
+        // linearize with the calibrated correction table
+        position = groupOfElements->positionLut[position];
+    }
+#endif
+    #ifndef RAM_FOR_FLASH
+    free(measCnt);
+    #endif
+#ifdef SENSOR_CALLBACKS
+    Callback_Dispatch(groupOfElements, (position >= 0), position, 1);
+#endif
+    return position;
+}
+#endif
+
+#ifdef MATRIX
+/***************************************************************************//**
+ * @brief   Measure one line (rows or columns) of a matrix keypad
+ * @param   groupOfElements Pointer to the row or column sensor
+ * @param   deltaCnt Address to where the measurements are to be written
+ * @param   active Address to where the number of elements that exceed their
+ *          threshold is written
+ * @return  result index of the dominant element or ILLEGAL_MATRIX_KEY if no
+ *          element exceeds its threshold
+ ******************************************************************************/
+static uint16_t Matrix_Line(const struct Sensor* groupOfElements,
+                            cts_count_t* deltaCnt, uint16_t* active)
+{
+    uint16_t i;
+
+    *active = 0;
+    TI_CAPT_Custom(groupOfElements, deltaCnt);
+    if(!(ctsStatusReg & EVNT))
+    {
+        return ILLEGAL_MATRIX_KEY;
+    }
+    for(i=0; i < groupOfElements->numElements; i++)
+    {
+        if(deltaCnt[i] >= TOUCH_THRESHOLD(groupOfElements, i))
+        {
+            (*active)++;
+        }
+    }
+    return Dominant_Element(groupOfElements, deltaCnt);
+}
+
+/***************************************************************************//**
+ * @brief   Determine which key of a row/column matrix keypad is pressed
+ *
+ *          Each key lies at the intersection of one row and one column
+ *          electrode, so N rows and M columns form N*M keys.  The rows and
+ *          the columns are each measured as a sensor and the key is the
+ *          intersection of the dominant row and the dominant column.  When
+ *          more than one row and more than one column exceed their threshold
+ *          the intersections are ambiguous (ghost keys) and no key is
+ *          reported.
+ * @param   rows Pointer to the sensor of row electrodes
+ * @param   columns Pointer to the sensor of column electrodes
+ * @return  result key index (row * columns->numElements + column) or
+ *          ILLEGAL_MATRIX_KEY if no key is pressed
+ ******************************************************************************/
+uint16_t TI_CAPT_Matrix(const struct Sensor* rows, const struct Sensor* columns)
+{
+    uint16_t row, column;
+    uint16_t rowsActive, columnsActive;
+    uint16_t key = ILLEGAL_MATRIX_KEY;
+    // allocate memory for measurement, shared by rows and columns
+    #ifndef RAM_FOR_FLASH
+    cts_count_t *measCnt;
+    uint16_t size = rows->numElements;
+    if(columns->numElements > size)
+    {
+        size = columns->numElements;
+    }
+    measCnt = (cts_count_t *)malloc(size * sizeof(cts_count_t));
+    if(measCnt ==0)
+    {
+        while(1);
+    }
+    #endif
+    // measure both lines every time so that both baselines keep tracking
+    row = Matrix_Line(rows, measCnt, &rowsActive);
+    column = Matrix_Line(columns, measCnt, &columnsActive);
+    #ifndef RAM_FOR_FLASH
+    free(measCnt);
+    #endif
+    if((row != ILLEGAL_MATRIX_KEY) && (column != ILLEGAL_MATRIX_KEY)
+       && ((rowsActive < 2) || (columnsActive < 2)))
+    {
+        key = row * columns->numElements + column;
+    }
+    return key;
+}
+#endif
+
+#ifdef TOUCHPAD
+/***************************************************************************//**
+ * @brief   Centroid of one axis of a touchpad
+ * @param   axis Pointer to the X or Y sensor
+ * @param   deltaCnt Address of the measurements of the axis
+ * @param   size Address to where the sum of the responses is written
+ * @return  result centroid, 0 to points-1, or ILLEGAL_SLIDER_WHEEL_POSITION
+ *          if the sum of the responses is below sensorThreshold
+ ******************************************************************************/
+static uint16_t Touchpad_Axis(const struct Sensor* axis, cts_count_t* deltaCnt,
+                              uint16_t* size)
+{
+    uint16_t i;
+    uint32_t moment = 0;
+
+    *size = 0;
+    // normalize each response to a percentage of its maximum response
+    Dominant_Element(axis, deltaCnt);
+    for(i=0; i < axis->numElements; i++)
+    {
+        // the centre of element i lies at (i+1/2)*points/numElements
+        moment += (uint32_t)(2*i+1) * deltaCnt[i];
+        *size += deltaCnt[i];
+    }
+    if(*size < axis->sensorThreshold)
+    {
+        return ILLEGAL_SLIDER_WHEEL_POSITION;
+    }
+    return (moment * axis->points)
+           / (2 * (uint32_t)axis->numElements * (*size));
+}
+
+/***************************************************************************//**
+ * @brief   Determine the position on a touchpad
+ *
+ *          The touchpad is formed by a sensor of X electrodes and a sensor of
+ *          Y electrodes that cross each other.  Both are measured within one
+ *          call (frame) and the position on each axis is the centroid of the
+ *          normalized responses in fixed point, 0 to points-1.  The touch
+ *          size is the sum of the responses of both axes in percent of the
+ *          maximum response of an element.
+ *          With RAM_FOR_FLASH MAXIMUM_NUMBER_OF_ELEMENTS_PER_SENSOR must hold
+ *          the X and the Y elements.
+ * @param   xAxis Pointer to the sensor of X electrodes
+ * @param   yAxis Pointer to the sensor of Y electrodes
+ * @param   position Address to where the position and size are written,
+ *          x and y are ILLEGAL_SLIDER_WHEEL_POSITION if there is no touch
+ * @return  result Indication if the touchpad is (1) or is not (0) touched
+ ******************************************************************************/
+uint8_t TI_CAPT_Touchpad(const struct Sensor* xAxis, const struct Sensor* yAxis,
+                         struct TouchpadPosition* position)
+{
+    uint8_t result = 0;
+    uint16_t xEvent, ySize;
+    // allocate memory for measurement of both axes
+    #ifndef RAM_FOR_FLASH
+    cts_count_t *measCnt;
+    measCnt = (cts_count_t *)malloc((xAxis->numElements + yAxis->numElements)
+                                    * sizeof(cts_count_t));
+    if(measCnt ==0)
+    {
+        while(1);
+    }
+    #endif
+    position->x = ILLEGAL_SLIDER_WHEEL_POSITION;
+    position->y = ILLEGAL_SLIDER_WHEEL_POSITION;
+    position->size = 0;
+    //make measurement
+    TI_CAPT_Custom(xAxis, &measCnt[0]);
+    xEvent = ctsStatusReg & EVNT;
+    TI_CAPT_Custom(yAxis, &measCnt[xAxis->numElements]);
+    if(xEvent && (ctsStatusReg & EVNT))
+    {
+        position->x = Touchpad_Axis(xAxis, &measCnt[0], &position->size);
+        position->y = Touchpad_Axis(yAxis, &measCnt[xAxis->numElements],
+                                    &ySize);
+        position->size += ySize;
+        if((position->x == ILLEGAL_SLIDER_WHEEL_POSITION)
+           || (position->y == ILLEGAL_SLIDER_WHEEL_POSITION))
+        {
+            position->x = ILLEGAL_SLIDER_WHEEL_POSITION;
+            position->y = ILLEGAL_SLIDER_WHEEL_POSITION;
+        }
+        else
+        {
+            result = 1;
+        }
+    }
     #ifndef RAM_FOR_FLASH
     free(measCnt);
     #endif
+    return result;
+}
+#endif
+
+#ifdef POSITION_TRACKING
+/***************************************************************************//**
+ * @brief   Alpha-beta tracking of a slider or wheel position
+ *
+ *          The position and velocity are estimated in 1/256 points.  Each
+ *          scan the estimate is predicted one scan ahead and corrected by
+ *          TRACKING_ALPHA and TRACKING_BETA (in 1/256) of the residual.  The
+ *          output is predicted TRACKING_LEAD scans ahead to compensate the
+ *          lag of the filter.  With a wheel the residual and the position
+ *          wrap around at points.
+ * @param   tracker Pointer to the tracking state of the sensor
+ * @param   measured Position returned by TI_CAPT_Slider or TI_CAPT_Wheel
+ * @param   points Number of points of the slider or wheel
+ * @param   wheel Wrap around at points (1) or limit to 0 to points (0)
+ * @return  result tracked position or ILLEGAL_SLIDER_WHEEL_POSITION if no touch
+ ******************************************************************************/
+static uint16_t Track_Position(struct PositionTracker* tracker,
+                               uint16_t measured, uint16_t points, uint8_t wheel)
+{
+    int32_t residual, output;
+    int32_t range = (int32_t)points * 256;
+
+    if(measured == ILLEGAL_SLIDER_WHEEL_POSITION)
+    {
+        // release, restart tracking with the next touch
+        tracker->valid = 0;
+        return ILLEGAL_SLIDER_WHEEL_POSITION;
+    }
+    if(!tracker->valid)
+    {
+        tracker->position = (int32_t)measured * 256;
+        tracker->velocity = 0;
+        tracker->valid = 1;
+        return measured;
+    }
+    // predict and correct
+    tracker->position += tracker->velocity;
+    residual = (int32_t)measured * 256 - tracker->position;
+    if(wheel)
+    {
+        // take the shorter way around the wheel
+        while(residual >= range/2)
+        {
+            residual -= range;
+        }
+        while(residual < -range/2)
+        {
+            residual += range;
+        }
+    }
+    tracker->position += (TRACKING_ALPHA * residual) / 256;
+    tracker->velocity += (TRACKING_BETA * residual) / 256;
+    output = tracker->position + TRACKING_LEAD * tracker->velocity;
+    if(wheel)
+    {
+        while(tracker->position < 0)
+        {
+            tracker->position += range;
+        }
+        while(tracker->position >= range)
+        {
+            tracker->position -= range;
+        }
+        output = (output + 128) / 256;
+        while(output < 0)
+        {
+            output += points;
+        }
+        while(output >= points)
+        {
+            output -= points;
+        }
+    }
+    else
+    {
+        if(tracker->position < 0)
+        {
+            tracker->position = 0;
+        }
+        else if(tracker->position > range)
+        {
+            tracker->position = range;
+        }
+        if(output < 0)
+        {
+            output = 0;
+        }
+        else if(output > range)
+        {
+            output = range;
+        }
+        output = (output + 128) / 256;
+    }
+    return (uint16_t)output;
+}
+
+#ifdef SLIDER
+/***************************************************************************//**
+ * @brief   Determine the smoothed position on a slider
+ * @param   groupOfElements Pointer to slider
+ * @param   tracker Pointer to the tracking state of the slider, zero
+ *          initialized before the first call
+ * @return  result tracked position on slider or illegal value if no touch
+ ******************************************************************************/
+uint16_t TI_CAPT_Tracked_Slider(const struct Sensor* groupOfElements,
+                                struct PositionTracker* tracker)
+{
+    return Track_Position(tracker, TI_CAPT_Slider(groupOfElements),
+                          groupOfElements->points, 0);
+}
+#endif
+
+#ifdef WHEEL
+/***************************************************************************//**
+ * @brief   Determine the smoothed position on a wheel
+ * @param   groupOfElements Pointer to wheel
+ * @param   tracker Pointer to the tracking state of the wheel, zero
+ *          initialized before the first call
+ * @return  result tracked position on wheel or illegal value if no touch
+ ******************************************************************************/
+uint16_t TI_CAPT_Tracked_Wheel(const struct Sensor* groupOfElements,
+                               struct PositionTracker* tracker)
+{
+    return Track_Position(tracker, TI_CAPT_Wheel(groupOfElements),
+                          groupOfElements->points, 1);
+}
+#endif
+#endif
+
+#ifdef SLIDER_LUT
+/***************************************************************************//**
+ * @brief   Fill a position correction table from the raw knot positions
+ *
+ *          Knot k is at k*points/segments, and the table is filled by
+ *          piecewise-linear interpolation between the knots.  On a wheel raw
+ *          position points is raw position 0: the raw positions are taken
+ *          modulo points and unwrapped to increase from rawKnots[0] on, knot
+ *          segments is knot 0 once round, and the corrected positions are
+ *          reduced modulo points.  With no segments the table is set to the
+ *          identity.
+ * @param   groupOfElements Pointer to slider or wheel with positionLut
+ * @param   rawKnots Raw positions measured at the knots
+ * @param   segments Number of segments between the knots
+ * @param   wheel 1 for a wheel, 0 for a slider
+ * @return  none
+ ******************************************************************************/
+static void Calibrate_Lut(const struct Sensor* groupOfElements,
+                          const uint16_t* rawKnots, uint8_t segments,
+                          uint8_t wheel)
+{
+    uint16_t raw, position;
+    uint16_t rawStart, rawEnd, knotStart, knotEnd;
+    uint8_t k;
+    uint16_t points = groupOfElements->points;
+
+    for(raw = 0; raw <= points; raw++)
+    {
+        position = raw;
+        if(wheel)
+        {
+            position %= points;
+        }
+        if(segments)
+        {
+            rawEnd = rawKnots[0];
+            if(wheel)
+            {
+                rawEnd %= points;
+                if(position < rawEnd)
+                {
+                    position += points;
+                }
+            }
+            // find the segment rawStart <= position < rawEnd of knot k
+            for(k = 0; ; k++)
+            {
+                rawStart = rawEnd;
+                if(!wheel)
+                {
+                    rawEnd = rawKnots[k+1];
+                }
+                else if(k+1 == segments)
+                {
+                    rawEnd = (rawKnots[0] % points) + points;
+                }
+                else
+                {
+                    rawEnd = rawStart + ((rawKnots[k+1] % points) + points
+                                         - (rawStart % points)) % points;
+                }
+                if((k+1 == segments) || (position < rawEnd))
+                {
+                    break;
+                }
+            }
+            knotStart = ((uint32_t)k * points) / segments;
+            knotEnd = ((uint32_t)(k+1) * points) / segments;
+            if(position <= rawStart)
+            {
+                position = knotStart;
+            }
+            else if(position >= rawEnd)
+            {
+                position = knotEnd;
+            }
+            else
+            {
+                position = knotStart
+                         + ((uint32_t)(position - rawStart) * (knotEnd - knotStart))
+                           / (rawEnd - rawStart);
+            }
+            if(wheel && (position >= points))
+            {
+                position -= points;
+            }
+        }
+        groupOfElements->positionLut[raw] = position;
+    }
+}
+
+/***************************************************************************//**
+ * @brief   Fill the position correction table of a slider
+ *
+ *          The calibration sweep touches the slider at numberOfKnots equally
+ *          spaced points, knot k at k*points/(numberOfKnots-1), and records
+ *          the position returned by TI_CAPT_Slider (with the table still at
+ *          the identity) in rawKnots.  The table is then filled by
+ *          piecewise-linear interpolation between the knots so that the
+ *          position path only needs one lookup.  The raw positions must not
+ *          decrease from one knot to the next.  With less than two knots the
+ *          table is set to the identity.  A wheel is calibrated with
+ *          TI_CAPT_Calibrate_Wheel_Lut.
+ * @param   groupOfElements Pointer to slider with positionLut
+ * @param   rawKnots Raw positions measured at the knots
+ * @param   numberOfKnots Number of knots
+ * @return  none
+ ******************************************************************************/
+void TI_CAPT_Calibrate_Position_Lut(const struct Sensor* groupOfElements,
+                                    const uint16_t* rawKnots,
+                                    uint8_t numberOfKnots)
+{
+    Calibrate_Lut(groupOfElements, rawKnots,
+                  numberOfKnots < 2 ? 0 : numberOfKnots - 1, 0);
+}
+
+#ifdef WHEEL
+/***************************************************************************//**
+ * @brief   Fill the position correction table of a wheel
+ *
+ *          The calibration sweep touches the wheel once round at
+ *          numberOfKnots equally spaced points, knot k at
+ *          k*points/numberOfKnots, and records the position returned by
+ *          TI_CAPT_Wheel (with the table still at the identity) in rawKnots.
+ *          The knot at points is knot 0 again and is not measured.  Going
+ *          round, the raw positions must not decrease modulo points, so they
+ *          may wrap through 0 once.  The table maps every raw position to
+ *          0..points-1.  Without knots the table is set to the identity
+ *          modulo points.
+ * @param   groupOfElements Pointer to wheel with positionLut
+ * @param   rawKnots Raw positions measured at the knots
+ * @param   numberOfKnots Number of knots
+ * @return  none
+ ******************************************************************************/
+void TI_CAPT_Calibrate_Wheel_Lut(const struct Sensor* groupOfElements,
+                                 const uint16_t* rawKnots,
+                                 uint8_t numberOfKnots)
+{
+    Calibrate_Lut(groupOfElements, rawKnots, numberOfKnots, 1);
+}
+#endif
+#endif
+
+#ifdef ROI_SCAN
+/***************************************************************************//**
+ * @brief   Select a full or a region scan for a TI_CAPT_Roi_xxx call
+ * @param   roi Pointer to the region of interest state of the sensor
+ * @return  none
+ ******************************************************************************/
+static void Roi_Begin(struct RoiState* roi)
+{
+    roi->partial = 0;
+    if(roi->tracking && (roi->scans < ROI_FULL_SCAN_INTERVAL))
+    {
+        // touch tracked: measure the region around the dominant element
+        roi->partial = 1;
+        roi->scans++;
+    }
+    else
+    {
+        // refresh all baselines and look for new touches
+        roi->scans = 0;
+    }
+    ctsRoi = roi;
+}
+
+/***************************************************************************//**
+ * @brief   Update the region of interest state after a TI_CAPT_Roi_xxx call
+ * @param   roi Pointer to the region of interest state of the sensor
+ * @return  none
+ ******************************************************************************/
+static void Roi_End(struct RoiState* roi)
+{
+    // the dominant element was recorded in roi->center by Dominant_Element
+    roi->tracking = (ctsStatusReg & EVNT) ? 1 : 0;
+    ctsRoi = 0;
+}
+
+/***************************************************************************//**
+ * @brief   Determine which button if any is being pressed, measuring only
+ *          the region of the last pressed button while it is pressed
+ * @param   groupOfElements Pointer to buttons to be scanned
+ * @param   roi Pointer to the region of interest state of the buttons, zero
+ *          initialized before the first call
+ * @return  result pointer to element (button) being pressed or 0 none
+ ******************************************************************************/
+const struct Element *TI_CAPT_Roi_Buttons(const struct Sensor *groupOfElements,
+                                          struct RoiState* roi)
+{
+    const struct Element *result;
+
+    Roi_Begin(roi);
+    result = TI_CAPT_Buttons(groupOfElements);
+    Roi_End(roi);
+    return result;
+}
+
+#ifdef SLIDER
+/***************************************************************************//**
+ * @brief   Determine the position on a slider, measuring only the region of
+ *          the touch while a touch is tracked
+ * @param   groupOfElements Pointer to slider
+ * @param   roi Pointer to the region of interest state of the slider, zero
+ *          initialized before the first call
+ * @return  result position on slider or illegal value if no touch
+ ******************************************************************************/
+uint16_t TI_CAPT_Roi_Slider(const struct Sensor* groupOfElements,
+                            struct RoiState* roi)
+{
+    uint16_t position;
+
+    Roi_Begin(roi);
+    position = TI_CAPT_Slider(groupOfElements);
+    Roi_End(roi);
     return position;
 }
 #endif
 
+#ifdef WHEEL
+/***************************************************************************//**
+ * @brief   Determine the position on a wheel, measuring only the region of
+ *          the touch while a touch is tracked
+ * @param   groupOfElements Pointer to wheel
+ * @param   roi Pointer to the region of interest state of the wheel, zero
+ *          initialized before the first call
+ * @return  result position on wheel or illegal value if no touch
+ ******************************************************************************/
+uint16_t TI_CAPT_Roi_Wheel(const struct Sensor* groupOfElements,
+                           struct RoiState* roi)
+{
+    uint16_t position;
+
+    Roi_Begin(roi);
+    position = TI_CAPT_Wheel(groupOfElements);
+    Roi_End(roi);
+    return position;
+}
+#endif
+#endif
+
+#ifdef SENSOR_CALLBACKS
+/***************************************************************************//**
+ * @brief   Register the callbacks of a sensor
+ *
+ *          After registration TI_CAPT_Buttons(), TI_CAPT_Slider() and
+ *          TI_CAPT_Wheel() call the callbacks of the sensor when a scan
+ *          changes its state, and nothing otherwise.  Registering a sensor
+ *          again replaces its callbacks, a callbacks pointer of 0 removes
+ *          them.  The callbacks structure must remain valid while registered.
+ * @param   groupOfElements Pointer to the sensor
+ * @param   callbacks Pointer to the callbacks of the sensor, or 0
+ * @return  result Indication if the callbacks were (1) or were not (0)
+ *          registered; at most CALLBACK_SENSORS sensors can be registered
+ ******************************************************************************/
+uint8_t TI_CAPT_Register_Callbacks(const struct Sensor* groupOfElements,
+                                   struct SensorCallbacks* callbacks)
+{
+    uint8_t i;
+    uint8_t slot = CALLBACK_SENSORS;
+
+    for(i = 0; i < CALLBACK_SENSORS; i++)
+    {
+        if(ctsCallbacks[i] && (ctsCallbacks[i]->sensor == groupOfElements))
+        {
+            slot = i;
+            break;
+        }
+        if(!ctsCallbacks[i] && (slot == CALLBACK_SENSORS))
+        {
+            slot = i;
+        }
+    }
+    if(slot == CALLBACK_SENSORS)
+    {
+        return (callbacks == 0);
+    }
+    if(callbacks)
+    {
+        callbacks->sensor = groupOfElements;
+        callbacks->touched = 0;
+        callbacks->value = 0;
+    }
+    ctsCallbacks[slot] = callbacks;
+    return 1;
+}
+#endif
+
+#ifdef STUCK_TOUCH_RECOVERY
+/***************************************************************************//**
+ * @brief   Re-baseline a sensor over the next scans
+ *
+ *          Non-blocking alternative to TI_CAPT_Init_Baseline() followed by
+ *          TI_CAPT_Update_Baseline(): the baseline of each element moves to
+ *          the measurements of the next RECOVERY_SCANS scans of the sensor,
+ *          during which the elements report no change.  The same recovery is
+ *          started for an element that stays above its threshold for
+ *          STUCK_TOUCH_SCANS consecutive scans.
+ * @param   groupOfElements Pointer to the sensor
+ * @return  none
+ ******************************************************************************/
+void TI_CAPT_Recover_Baseline(const struct Sensor* groupOfElements)
+{
+    uint16_t i;
+
+    for(i = groupOfElements->baseOffset;
+        i < groupOfElements->baseOffset + groupOfElements->numElements; i++)
+    {
+        ctsOnScans[i] = 0;
+        ctsRecoveryScans[i] = RECOVERY_SCANS;
+    }
+}
+#endif
+
 /** @} */
 
 /***************************************************************************//**
@@ -967,14 +1887,16 @@ uint16_t TI_CAPT_Wheel(const struct Sensor* groupOfElements)
  * @param   deltaCnt Address to where the measurements are to be written
  * @return  result index to the element which is dominant
  ******************************************************************************/
-uint8_t Dominant_Element(const struct Sensor* groupOfElements, uint16_t* deltaCnt)
+uint16_t Dominant_Element(const struct Sensor* groupOfElements, cts_count_t* deltaCnt)
 {
-    uint8_t i;
+    uint16_t i;
     uint16_t percentDelta=0; 
-    uint8_t dominantElement=0;
+    uint16_t dominantElement=0;
+    uint16_t threshold;
     for(i=0;i<groupOfElements->numElements;i++)
     {  
-        if(deltaCnt[i]>=(groupOfElements->arrayPtr[i])->threshold)
+        threshold = (groupOfElements->arrayPtr[i])->threshold;
+        if(deltaCnt[i] >= TOUCH_THRESHOLD(groupOfElements, i))
         {
             if(deltaCnt[i] > ((groupOfElements->arrayPtr[i])->maxResponse))
             {
@@ -982,11 +1904,18 @@ uint8_t Dominant_Element(const struct Sensor* groupOfElements, uint16_t* deltaCn
                 // limit response to the maximum
             }
             // (maxResponse - threshold) cannot exceed 655
-            // 100*(delta - threshold) / (maxResponse - threshold)
-            deltaCnt[i] = (100*(deltaCnt[i]
-                           -(groupOfElements->arrayPtr[i])->threshold))
-            		         /((groupOfElements->arrayPtr[i])->maxResponse
-            				    -(groupOfElements->arrayPtr[i])->threshold);
+            // 100*(delta - threshold) / (maxResponse - threshold), 0 for a
+            // touched element that is still below threshold
+            if(deltaCnt[i] > threshold)
+            {
+                deltaCnt[i] = (100*(deltaCnt[i]-threshold))
+                              /((groupOfElements->arrayPtr[i])->maxResponse
+                                -threshold);
+            }
+            else
+            {
+                deltaCnt[i] = 0;
+            }
             if(deltaCnt[i] >= percentDelta)
             {
                 //update percentDelta
@@ -999,6 +1928,12 @@ uint8_t Dominant_Element(const struct Sensor* groupOfElements, uint16_t* deltaCn
             deltaCnt[i] = 0;
         }
     } // end for loop
+#ifdef ROI_SCAN
+    if(ctsRoi)
+    {
+        ctsRoi->center = dominantElement;
+    }
+#endif
     return dominantElement;
 }
 #endif
@@ -107,6 +107,66 @@
 //! @}
 
 
+#ifdef TOUCHPAD
+/*!
+ *  Position and size of a touch on a touchpad, see TI_CAPT_Touchpad()
+ */
+struct TouchpadPosition{
+  uint16_t x;                      // 0 to points-1 of the X sensor
+  uint16_t y;                      // 0 to points-1 of the Y sensor
+  uint16_t size;                   // sum of the responses, in percent
+};
+#endif
+
+
+#ifdef POSITION_TRACKING
+/*!
+ *  Tracking state of a slider or wheel, see TI_CAPT_Tracked_Slider() and
+ *  TI_CAPT_Tracked_Wheel()
+ */
+struct PositionTracker{
+  int32_t position;                // estimated position, 1/256 points
+  int32_t velocity;                // estimated velocity, 1/256 points per scan
+  uint8_t valid;                   // 0: no touch in the previous scan
+};
+#endif
+
+
+#ifdef ROI_SCAN
+/*!
+ *  Region of interest state of a sensor, see TI_CAPT_Roi_Buttons(),
+ *  TI_CAPT_Roi_Slider() and TI_CAPT_Roi_Wheel()
+ */
+struct RoiState{
+  uint16_t center;                 // dominant element of the last touch
+  uint8_t tracking;                // 1: touch detected in the last scan
+  uint8_t partial;                 // 1: current scan measures the region only
+  uint8_t scans;                   // region scans since the last full scan
+};
+#endif
+
+
+#ifdef SENSOR_CALLBACKS
+/*!
+ *  Callbacks of a sensor, see TI_CAPT_Register_Callbacks().  The value passed
+ *  to press and release is the element index for buttons and the position for
+ *  sliders and wheels.  Unused callbacks are 0.
+ */
+struct SensorCallbacks{
+  void (*press)(const struct Sensor*, uint16_t);
+  void (*release)(const struct Sensor*, uint16_t);
+  void (*positionChange)(const struct Sensor*, uint16_t); // sliders, wheels
+  // buttons: tables of numElements callbacks indexed by element, or 0
+  void (* const *elementPress)(void);
+  void (* const *elementRelease)(void);
+  // state maintained by the library
+  const struct Sensor *sensor;
+  uint16_t value;
+  uint8_t touched;
+};
+#endif
+
+
 // API Calls
 void TI_CAPT_Init_Baseline(const struct Sensor*);
 void TI_CAPT_Update_Baseline(const struct Sensor*, uint8_t);
@@ -115,16 +175,46 @@ void TI_CAPT_Reset_Tracking(void);
 void TI_CAPT_Update_Tracking_DOI(uint8_t);
 void TI_CAPT_Update_Tracking_Rate(uint8_t);
 
-void TI_CAPT_Raw(const struct Sensor*, uint16_t*);
+void TI_CAPT_Raw(const struct Sensor*, cts_count_t*);
 
-void TI_CAPT_Custom(const struct Sensor *, uint16_t*);
+void TI_CAPT_Custom(const struct Sensor *, cts_count_t*);
 
 uint8_t TI_CAPT_Button(const struct Sensor *);
 const struct Element * TI_CAPT_Buttons(const struct Sensor *);
 uint16_t TI_CAPT_Slider(const struct Sensor*);
 uint16_t TI_CAPT_Wheel(const struct Sensor*);
+uint16_t TI_CAPT_Matrix(const struct Sensor*, const struct Sensor*);
+#ifdef TOUCHPAD
+uint8_t TI_CAPT_Touchpad(const struct Sensor*, const struct Sensor*,
+                         struct TouchpadPosition*);
+#endif
+#ifdef POSITION_TRACKING
+uint16_t TI_CAPT_Tracked_Slider(const struct Sensor*, struct PositionTracker*);
+uint16_t TI_CAPT_Tracked_Wheel(const struct Sensor*, struct PositionTracker*);
+#endif
+#ifdef SLIDER_LUT
+void TI_CAPT_Calibrate_Position_Lut(const struct Sensor*, const uint16_t*,
+                                    uint8_t);
+#ifdef WHEEL
+void TI_CAPT_Calibrate_Wheel_Lut(const struct Sensor*, const uint16_t*,
+                                 uint8_t);
+#endif
+#endif
+#ifdef ROI_SCAN
+const struct Element * TI_CAPT_Roi_Buttons(const struct Sensor *,
+                                           struct RoiState*);
+uint16_t TI_CAPT_Roi_Slider(const struct Sensor*, struct RoiState*);
+uint16_t TI_CAPT_Roi_Wheel(const struct Sensor*, struct RoiState*);
+#endif
+#ifdef SENSOR_CALLBACKS
+uint8_t TI_CAPT_Register_Callbacks(const struct Sensor*,
+                                   struct SensorCallbacks*);
+#endif
+#ifdef STUCK_TOUCH_RECOVERY
+void TI_CAPT_Recover_Baseline(const struct Sensor*);
+#endif
 
 // Internal Calls
-uint8_t Dominant_Element (const struct Sensor*, uint16_t*);
+uint16_t Dominant_Element (const struct Sensor*, cts_count_t*);
 
 #endif /* CTS_LAYER_H_ */
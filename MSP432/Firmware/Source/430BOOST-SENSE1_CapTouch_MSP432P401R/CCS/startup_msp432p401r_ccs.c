@@ -96,7 +96,6 @@ extern void TA3_0_IRQHandler(void);
 #ifdef fRO_CTIO_TA2_TA3
 extern void TA2_0_IRQHandler(void);
 #endif
-extern void EUSCIA0_IRQHandler(void);
 extern void TA0_0_IRQHandler(void);
 /* To be added by user */
 
@@ -153,7 +152,7 @@ void (* const interruptVectors[])(void) =
 	defaultISR,								/*  TA3_0 ISR				 */
 #endif
     defaultISR,                             /* TA3_N ISR                 */
-    EUSCIA0_IRQHandler,                             /* EUSCIA0 ISR               */
+    defaultISR,                             /* EUSCIA0 ISR               */
     defaultISR,                             /* EUSCIA1 ISR               */
     defaultISR,                             /* EUSCIA2 ISR               */
     defaultISR,                             /* EUSCIA3 ISR               */
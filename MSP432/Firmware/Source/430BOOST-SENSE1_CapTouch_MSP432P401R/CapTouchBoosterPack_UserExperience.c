@@ -51,6 +51,7 @@
 #include "CTS_Layer.h"
 
 #include "uart.h"
+#include "clock.h"
 
 //******************************************************************************
 // UART Interface defines
@@ -190,7 +191,7 @@ uint16_t wheel_position=ILLEGAL_SLIDER_WHEEL_POSITION, last_wheel_position=ILLEG
 
 //! \brief Stores single count value due to change in capacitance
 //!
-uint16_t deltaCnts[1];
+cts_count_t deltaCnts[1];
 
 //! \brief Stores raw counts from proximity sensor
 //!
@@ -200,6 +201,10 @@ uint16_t prox_raw_Cnts;
 // Function Prototypes
 //*******************************************************************************
 
+//! \brief Changes the clock operating point, keeping the UART baud rate
+//!
+void System_setOperatingPoint(uint8_t point);
+
 //! \brief Used to configure Digital I/Os that control
 //!        LEDs on the BoosterPack
 //!
@@ -229,7 +234,7 @@ uint8_t CTBP_getGesture(uint8_t position);
 void CTBP_processInput(void);
 
 #ifdef UART_ENABLED
-void UART_sendTouchByte(uint8_t touch);
+void UART_sendTouchBytes(uint8_t first, uint8_t second);
 #endif
 
 
@@ -245,11 +250,11 @@ int main(void)
     /* Setup Clocks: DCO to 1MHz and SMCLK to DCO/8 = 125kHz, MCLK = DCO, ACLK = REFO */
     /* MAP_function will use ROM version of function if available                     */
     MAP_FPU_enableModule();				// Enable FPU for DCO frequency calculation
-    MAP_CS_setDCOFrequency(CS_1MHZ); 	// Set DCO Frequency to 1MHz
+    Clock_init(CLOCK_SLEEP_SCAN);
 
-    MAP_CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_8);		//Source DCO/8 for SMCLK
-    MAP_CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);		//Source DCO for MCLK, no divider
-    MAP_CS_initClockSignal(CS_ACLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_1);		//Source REFO for ACLK
+#ifdef UART_ENABLED
+    UART_init(Clock_getSMCLK());        // UART stays configured from now on
+#endif
 
     NVIC_EnableIRQ(TA0_0_IRQn); //Enable TA0 interrupt in NVIC
 
@@ -264,6 +269,30 @@ int main(void)
     }
 }
 
+//! \brief Changes the clock operating point. If it differs from the active
+//!        one, queued UART bytes are sent first and the UART baud rate
+//!        divisor follows the new SMCLK. The UART bytes are queued at
+//!        CLOCK_ACTIVE_SCAN and sent before changing to CLOCK_SLEEP_SCAN.
+//! \param point CLOCK_SLEEP_SCAN or CLOCK_ACTIVE_SCAN
+//!
+void System_setOperatingPoint(uint8_t point)
+{
+	if (point == Clock_getOperatingPoint())
+	{
+		return;
+	}
+
+#ifdef UART_ENABLED
+	UART_flush();
+#endif
+
+	Clock_setOperatingPoint(point);
+
+#ifdef UART_ENABLED
+	UART_setClock(Clock_getSMCLK());
+#endif
+}
+
 //! \brief Configures digital IOs to control the LEDs on the 430BOOST-SENSE1
 //!        BoosterPack using defined masks.
 //!
@@ -288,16 +317,12 @@ void CTBP_waitForProxEvent(void)
 
 #ifdef UART_ENABLED
 	/* Send status via UART: 'sleep' = [0xDE, 0xAD] */
-	UART_sendTouchByte(SLEEP_MODE_UART_CODE);
-	UART_sendTouchByte(SLEEP_MODE_UART_CODE2);
+	UART_sendTouchBytes(SLEEP_MODE_UART_CODE, SLEEP_MODE_UART_CODE2);
 #endif
 
 	/* Set DCO to 1MHz */
 	/* Set SMCLK to 1MHz / 8 = 125kHz */
-	MAP_CS_setDCOFrequency(CS_1MHZ); 	// Set DCO Frequency to 1MHz
-	MAP_CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_8);		//Source DCO/8 for SMCLK
-	MAP_CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);		//Source DCO for MCLK, no divider
-	MAP_CS_initClockSignal(CS_ACLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_1);		//Source REFO for ACLK
+	System_setOperatingPoint(CLOCK_SLEEP_SCAN);
 
 	TI_CAPT_Update_Baseline(&proximity_sensor,5);
 
@@ -318,7 +343,7 @@ void CTBP_waitForProxEvent(void)
 		__sleep();
 
 		TA0CCTL0 &= ~CCIE;
-		TI_CAPT_Custom(&proximity_sensor,(uint16_t *)deltaCnts);
+		TI_CAPT_Custom(&proximity_sensor,deltaCnts);
 	}
 	while (deltaCnts[0] <= PROXIMITY_THRESHOLD);
 
@@ -336,10 +361,7 @@ void CTBP_measureCapBaseLine(void)
 
 	/* Set DCO to 8MHz */
 	/* SMCLK = 8MHz/8 = 1MHz */
-	MAP_CS_setDCOFrequency(CS_8MHZ); 	// Set DCO Frequency to 8MHz
-	MAP_CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_8);		//Source DCO/8 for SMCLK
-	MAP_CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);		//Source DCO for MCLK, no divider
-	MAP_CS_initClockSignal(CS_ACLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_1);		//Source REFO for ACLK
+	System_setOperatingPoint(CLOCK_ACTIVE_SCAN);
 
 	TI_CAPT_Init_Baseline(&wheel);
 	TI_CAPT_Update_Baseline(&wheel,2);
@@ -499,25 +521,24 @@ void CTBP_processInput(void)
 
 #ifdef UART_ENABLED
 	/* Send status via UART: 'wake up' = [0xBE, 0xEF] */
-	UART_sendTouchByte(WAKE_UP_UART_CODE);
-	UART_sendTouchByte(WAKE_UP_UART_CODE2);
+	UART_sendTouchBytes(WAKE_UP_UART_CODE, WAKE_UP_UART_CODE2);
 #endif
 
 	idleCounter = 0;
 	activeCounter = 0;
 	gestureDetected = 0;
 
+	/* DCO 8MHz, SMCLK 1MHz; already active after CTBP_measureCapBaseLine */
+	System_setOperatingPoint(CLOCK_ACTIVE_SCAN);
+
 	while (idleCounter++ < MAX_IDLE_TIME)
 	{
-		/* Set DCO to 8MHz */
-		/* SMCLK = 8MHz/8 = 1MHz */
-		MAP_CS_setDCOFrequency(CS_8MHZ); 	// Set DCO Frequency to 8MHz
-		MAP_CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_8);		//Source DCO/8 for SMCLK
-		MAP_CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);		//Source DCO for MCLK, no divider
-		MAP_CS_initClockSignal(CS_ACLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_1);		//Source REFO for ACLK
-
 		TA0CCTL0 &= ~CCIE;
 
+#ifdef UART_ENABLED
+		UART_service();                 // Keep queued UART bytes moving
+#endif
+
 		wheel_position = ILLEGAL_SLIDER_WHEEL_POSITION;
 		wheel_position = TI_CAPT_Wheel(&wheel);
 
@@ -567,14 +588,12 @@ void CTBP_processInput(void)
 
 #ifdef UART_ENABLED
 					/* Transmit gesture start status update & position via UART to PC */
-					UART_sendTouchByte(GESTURE_START);
-					UART_sendTouchByte(last_wheel_position + GESTURE_POSITION_OFFSET);
+					UART_sendTouchBytes(GESTURE_START, last_wheel_position + GESTURE_POSITION_OFFSET);
 #endif
 				}
 				/* Transmit gesture & position via UART to PC */
 #ifdef UART_ENABLED
-				UART_sendTouchByte(gesture);
-				UART_sendTouchByte(wheel_position + GESTURE_POSITION_OFFSET);
+				UART_sendTouchBytes(gesture, wheel_position + GESTURE_POSITION_OFFSET);
 #endif
 			}
 			else
@@ -586,8 +605,7 @@ void CTBP_processInput(void)
 						/* Transmit wheel position [twice] via UART to PC */
 						wheelTouchCounter = 0;
 #ifdef UART_ENABLED
-						UART_sendTouchByte(wheel_position + WHEEL_POSITION_OFFSET );
-						UART_sendTouchByte(wheel_position + WHEEL_POSITION_OFFSET );
+						UART_sendTouchBytes(wheel_position + WHEEL_POSITION_OFFSET, wheel_position + WHEEL_POSITION_OFFSET);
 #endif
 					}
 				}
@@ -608,8 +626,7 @@ void CTBP_processInput(void)
 				{
 #ifdef UART_ENABLED
 					/* Transmit center button code [twice] via UART to PC */
-					UART_sendTouchByte(MIDDLE_BUTTON_CODE);
-					UART_sendTouchByte(MIDDLE_BUTTON_CODE);
+					UART_sendTouchBytes(MIDDLE_BUTTON_CODE, MIDDLE_BUTTON_CODE);
 #endif
 
 					centerButtonTouched = 1;
@@ -631,8 +648,7 @@ void CTBP_processInput(void)
 					{
 #ifdef UART_ENABLED
 						/* Transmit last wheel position [twice] via UART to PC */
-						UART_sendTouchByte(last_wheel_position  + WHEEL_POSITION_OFFSET );
-						UART_sendTouchByte(last_wheel_position  + WHEEL_POSITION_OFFSET );
+						UART_sendTouchBytes(last_wheel_position  + WHEEL_POSITION_OFFSET, last_wheel_position  + WHEEL_POSITION_OFFSET);
 #endif
 						wheelTouchCounter = WHEEL_TOUCH_DELAY - 1;
 					}
@@ -642,8 +658,7 @@ void CTBP_processInput(void)
 #ifdef UART_ENABLED
 					/* A gesture was registered previously */
 					/* Transmit status update: stop gesture tracking [twice] via UART to PC */
-					UART_sendTouchByte(GESTURE_STOP);
-					UART_sendTouchByte(GESTURE_STOP);
+					UART_sendTouchBytes(GESTURE_STOP, GESTURE_STOP);
 #endif
 				}
 			}
@@ -666,14 +681,18 @@ void CTBP_processInput(void)
 
 #ifdef UART_ENABLED
 
-//! \brief Sends a byte of data indicating touch type/gesture via UART
-//! \param touch contains the byte corresponding to the touch or gesture
+//! \brief Queues the two bytes of a touch type/gesture update for the UART.
+//!        Both or none are queued, so the PC receives complete pairs.
+//! \param first contains the byte corresponding to the touch or gesture
+//! \param second contains the second byte of the update
 //!
-void UART_sendTouchByte(uint8_t touch)
+void UART_sendTouchBytes(uint8_t first, uint8_t second)
 {
-	UART_init();
-	UART_tx(touch);
-	UART_shutdown();
+	uint8_t touch[2];
+
+	touch[0] = first;
+	touch[1] = second;
+	UART_write(touch, 2);
 }
 #endif
 
@@ -94,7 +94,6 @@ extern void TA3_0_IRQHandler(void);
 #ifdef fRO_CTIO_TA2_TA3
 extern void TA2_0_IRQHandler(void);
 #endif
-extern void EUSCIA0_IRQHandler(void);
 extern void TA0_0_IRQHandler(void);
 
 //*****************************************************************************
@@ -185,7 +184,7 @@ __root const uVectorEntry __vector_table[] @ ".intvec" =
     IntDefaultHandler,			  /*  TA3_0 ISR		       */
 #endif
     IntDefaultHandler,                      // TA3_N ISR
-    EUSCIA0_IRQHandler,                      // EUSCIA0 ISR
+    IntDefaultHandler,                      // EUSCIA0 ISR
     IntDefaultHandler,                      // EUSCIA1 ISR
     IntDefaultHandler,                      // EUSCIA2 ISR
     IntDefaultHandler,                      // EUSCIA3 ISR
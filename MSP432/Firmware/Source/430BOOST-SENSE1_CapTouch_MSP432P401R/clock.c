@@ -0,0 +1,141 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+//*******************************************************************************
+//  clock.c
+//
+//! \brief Clock operating points. The clock system settings last applied are
+//!        cached so that changing to an operating point only reprograms the
+//!        DCO and dividers that differ.
+//!
+//*******************************************************************************
+
+//*******************************************************************************
+// Includes
+//*******************************************************************************
+#include "clock.h"
+#include "driverlib.h"
+
+//*******************************************************************************
+// Clock Globals
+//*******************************************************************************
+
+//! \brief Settings of an operating point. MCLK is the DCO and ACLK is REFO
+//!        in all of them.
+//!
+struct ClockPoint
+{
+	uint32_t dcoFrequency;              // DCO and MCLK frequency in Hz
+	uint32_t smclkDivider;              // CS_CLOCK_DIVIDER_x of SMCLK
+	uint32_t smclkFrequency;            // resulting SMCLK frequency in Hz
+};
+
+//! \brief Operating points, indexed by CLOCK_SLEEP_SCAN and CLOCK_ACTIVE_SCAN
+//!
+static const struct ClockPoint Clock_points[CLOCK_POINTS] =
+{
+	{ CS_1MHZ, CS_CLOCK_DIVIDER_8, CS_1MHZ / 8 },
+	{ CS_8MHZ, CS_CLOCK_DIVIDER_8, CS_8MHZ / 8 }
+};
+
+//! \brief Operating point and clock system settings last applied
+//!
+uint8_t Clock_point = CLOCK_UNKNOWN;
+uint32_t Clock_dcoFrequency;
+uint32_t Clock_smclkDivider;
+
+
+//! \brief Configures MCLK and ACLK, which are the same in all operating
+//!        points, and applies the first operating point
+//! \param uint8_t point - CLOCK_SLEEP_SCAN or CLOCK_ACTIVE_SCAN
+//!
+void Clock_init(uint8_t point)
+{
+	MAP_CS_setDCOFrequency(Clock_points[point].dcoFrequency);
+	MAP_CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, Clock_points[point].smclkDivider);
+	MAP_CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);		//Source DCO for MCLK, no divider
+	MAP_CS_initClockSignal(CS_ACLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_1);		//Source REFO for ACLK
+
+	Clock_dcoFrequency = Clock_points[point].dcoFrequency;
+	Clock_smclkDivider = Clock_points[point].smclkDivider;
+	Clock_point = point;
+}
+
+//! \brief Changes to an operating point, reprogramming only the DCO
+//!        frequency and the SMCLK divider that differ from the current ones.
+//!        Nothing is done if the point is already active.
+//! \param uint8_t point - CLOCK_SLEEP_SCAN or CLOCK_ACTIVE_SCAN
+//!
+void Clock_setOperatingPoint(uint8_t point)
+{
+	if (point == Clock_point)
+	{
+		return;
+	}
+	if (Clock_point == CLOCK_UNKNOWN)
+	{
+		Clock_init(point);
+		return;
+	}
+
+	if (Clock_points[point].dcoFrequency != Clock_dcoFrequency)
+	{
+		MAP_CS_setDCOFrequency(Clock_points[point].dcoFrequency);
+		Clock_dcoFrequency = Clock_points[point].dcoFrequency;
+	}
+	if (Clock_points[point].smclkDivider != Clock_smclkDivider)
+	{
+		MAP_CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, Clock_points[point].smclkDivider);
+		Clock_smclkDivider = Clock_points[point].smclkDivider;
+	}
+	Clock_point = point;
+}
+
+//! \brief Returns the active operating point
+//! \return CLOCK_SLEEP_SCAN, CLOCK_ACTIVE_SCAN or CLOCK_UNKNOWN
+//!
+uint8_t Clock_getOperatingPoint(void)
+{
+	return Clock_point;
+}
+
+//! \brief Returns the SMCLK frequency of the active operating point without
+//!        reading back the clock system
+//! \return SMCLK frequency in Hz, 0 before Clock_init()
+//!
+uint32_t Clock_getSMCLK(void)
+{
+	if (Clock_point == CLOCK_UNKNOWN)
+	{
+		return 0;
+	}
+	return Clock_points[Clock_point].smclkFrequency;
+}
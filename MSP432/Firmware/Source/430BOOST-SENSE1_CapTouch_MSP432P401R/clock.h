@@ -0,0 +1,61 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+//*******************************************************************************
+//  clock.h
+//! \brief Definition file for the clock operating points of the application.
+//!        The RO gates of this application count VLO (WDTA) or ACLK
+//!        (Timer A3) periods, so the gate times do not change with the
+//!        operating point.
+//!
+//*******************************************************************************
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+#include "msp.h"
+
+//*******************************************************************************
+// Operating points
+//*******************************************************************************
+#define CLOCK_SLEEP_SCAN        0           // DCO 1MHz, SMCLK 125kHz: proximity scan
+#define CLOCK_ACTIVE_SCAN       1           // DCO 8MHz, SMCLK 1MHz: wheel and button scan, UART
+#define CLOCK_POINTS            2
+#define CLOCK_UNKNOWN           0xFF        // clock system not yet configured
+
+//*******************************************************************************
+// external functions
+//*******************************************************************************
+extern void Clock_init(uint8_t point);
+extern void Clock_setOperatingPoint(uint8_t point);
+extern uint8_t Clock_getOperatingPoint(void);
+extern uint32_t Clock_getSMCLK(void);
+
+#endif /* CLOCK_H_ */
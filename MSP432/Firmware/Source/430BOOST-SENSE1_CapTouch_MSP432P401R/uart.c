@@ -46,91 +46,242 @@
 // UART Globals
 //*******************************************************************************
 
-//! \brief Stores data for transmission
+//! \brief UART transmit ring buffer. Bytes from UART_txTail up to UART_txHead
+//!        are queued; the DMA sends UART_txBlock of them starting at
+//!        UART_txTail. The bytes of each UART_write() are stored in one
+//!        piece: bytes that do not fit before the end of the buffer start at
+//!        index 0, and UART_txEnd marks where the bytes before the wrap end.
 //!
-uint8_t UART_txData;
+uint8_t UART_txRing[UART_TX_RING_SIZE];
+uint16_t UART_txHead;
+uint16_t UART_txTail;
+uint16_t UART_txEnd;
+uint16_t UART_txBlock;
 
-
-//! \brief Function configures Timer_A for full-duplex UART operation
+//! \brief DMA control table, aligned to 1024 bytes as required by the DMA
 //!
-void UART_init(void)
-{
-	//Set DCO to 1MHz, SMCLK to 1MHz, MCLK to 1MHz, and source REFO for ACLK
-	MAP_CS_setDCOFrequency(CS_1MHZ);
+#if defined(__TI_COMPILER_VERSION__)
+#pragma DATA_ALIGN(UART_dmaControlTable, 1024)
+uint8_t UART_dmaControlTable[1024];
+#elif defined(__IAR_SYSTEMS_ICC__)
+#pragma data_alignment=1024
+uint8_t UART_dmaControlTable[1024];
+#else
+uint8_t UART_dmaControlTable[1024] __attribute__((aligned(1024)));
+#endif
 
-	MAP_CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
-	MAP_CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
-	MAP_CS_initClockSignal(CS_ACLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_1);
 
+//! \brief Function configures eUSCI_A0 for UART operation once. The
+//!        clock system is left unchanged; the divisor is set for the
+//!        current SMCLK frequency.
+//! \param uint32_t smclkFrequency - SMCLK frequency in Hz
+//!
+void UART_init(uint32_t smclkFrequency)
+{
 	// Configure 2-UART pins by selecting second function
 	P1SEL0 |= UART_RXD | UART_TXD;
 
-	// Enable eUSCIA0 interrupt in NVIC module
-	NVIC_EnableIRQ(EUSCIA0_IRQn);
-
 	// Configure UART
 	// Put eUSCI in reset
 	UCA0CTLW0 |= UCSWRST;
 	// Select SMCLK as eUSCI clock input
 	UCA0CTLW0 |= UCSSEL__SMCLK;
 
+	UART_setClock(smclkFrequency);
+
+	// The DMA moves queued bytes into UCA0TXBUF on each UCTXIFG. No
+	// interrupt is used: the HAL waits for the end of each gate in
+	// __sleep(), which the first interrupt ends.
+	MAP_DMA_enableModule();
+	MAP_DMA_setControlBase(UART_dmaControlTable);
+	MAP_DMA_assignChannel(DMA_CH0_EUSCIA0TX);
+	MAP_DMA_disableChannelAttribute(DMA_CH0_EUSCIA0TX, UDMA_ATTR_ALL);
+	MAP_DMA_setChannelControl(UDMA_PRI_SELECT | DMA_CH0_EUSCIA0TX,
+			UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE | UDMA_ARB_1);
+	UART_txHead = 0;
+	UART_txTail = 0;
+	UART_txEnd = 0;
+	UART_txBlock = 0;
+}
+
+//! \brief Sets the baud rate divisor for a new SMCLK frequency. Call
+//!        UART_flush() before changing SMCLK, then this function.
+//! \param uint32_t smclkFrequency - SMCLK frequency in Hz
+//!
+void UART_setClock(uint32_t smclkFrequency)
+{
+	// UCBRSx for the fractional part of SMCLK/UART_BAUD in 1/16
+	static const uint8_t brs[16] = {
+		0x00, 0x01, 0x08, 0x11, 0x22, 0x25, 0x4A, 0x53,
+		0x55, 0xAA, 0xAD, 0xD6, 0xBB, 0xEE, 0xEF, 0xFE };
+	uint32_t n16;
+
+	// N = SMCLK/UART_BAUD in 1/16
+	n16 = (16 * smclkFrequency + UART_BAUD / 2) / UART_BAUD;
+
+	// Put eUSCI in reset
+	UCA0CTLW0 |= UCSWRST;
+
 	// Baud Rate calculation
-	UCA0BR0 = 6;                                    // 1000000/9600/16
-	UCA0BR1 = 0x00;
-	UCA0MCTLW = 0x2000 | UCOS16 | 0x0080;
+	if (n16 >= 256)
+	{
+		// Oversampling: UCBRx = INT(N/16), UCBRFx = INT(FRAC(N/16)*16)
+		UCA0BR0 = (uint8_t) (n16 / 256);
+		UCA0BR1 = (uint8_t) (n16 / 65536);
+		UCA0MCTLW = (brs[n16 % 16] << 8) | (((n16 / 16) % 16) << 4) | UCOS16;
+	}
+	else
+	{
+		// Low frequency mode: UCBRx = INT(N)
+		UCA0BR0 = (uint8_t) (n16 / 16);
+		UCA0BR1 = 0x00;
+		UCA0MCTLW = (brs[n16 % 16] << 8);
+	}
 
 	// Initialize eUSCI
 	UCA0CTLW0 &= ~UCSWRST;
-
 }
 
 
-//! \brief Function unconfigures Timer_A for full-duplex UART operation
+//! \brief Function unconfigures eUSCI_A0 after sending the queued bytes
 //!
 void UART_shutdown(void)
 {
+	UART_flush();
+
 	P1SEL0 &= ~(UART_RXD | UART_TXD);                         // Reset 2-UART pin as second function
 	P1DIR &= ~UART_TXD;
 
-	__disable_interrupt();
-	NVIC_DisableIRQ(EUSCIA0_IRQn);  // Disable eUSCIA0 interrupt in NVIC module
-
-	UCA0IE &= ~UCTXIE;                                // Disable USCI_A0 TX interrupt
+	UCA0CTLW0 |= UCSWRST;                                     // Put eUSCI in reset
 }
 
-//! \brief Outputs one byte using the Timer_A UART
+//! \brief Queues one byte for transmission. Does not wait.
 //! \param uint8_t byte - The byte to be transmitted
+//! \return 1 if the byte was queued, 0 if it was dropped for lack of room
+//!
+uint8_t UART_tx(uint8_t byte)
+{
+	return UART_write(&byte, 1);
+}
+
+//! \brief Queues bytes for transmission, all or none of them. Does not wait.
+//! \param const uint8_t *data - bytes to be transmitted
+//! \param uint16_t length - number of bytes
+//! \return 1 if the bytes were queued, 0 if they were dropped for lack of room
 //!
-void UART_tx(uint8_t byte)
+uint8_t UART_write(const uint8_t *data, uint16_t length)
 {
-    UART_txData = byte;           // Load global variable
-    UCA0IE |= UCTXIE;             // Enable USCI_A0 TX interrupt
+	uint16_t start;
+	uint16_t i;
 
-    // Go to LPM0 until Tx ready
-    __enable_interrupt();
-    __sleep();
+	UART_service();
+	if (UART_txHead >= UART_txTail)
+	{
+		// Free: from the head to the end, then from 0 up to the tail
+		if (UART_txHead + length <= UART_TX_RING_SIZE)
+		{
+			start = UART_txHead;
+		}
+		else if (length < UART_txTail)
+		{
+			UART_txEnd = UART_txHead;
+			start = 0;
+		}
+		else
+		{
+			return 0;
+		}
+	}
+	else if (UART_txHead + length < UART_txTail)
+	{
+		start = UART_txHead;
+	}
+	else
+	{
+		return 0;
+	}
+	for (i = 0; i < length; i++)
+	{
+		UART_txRing[start + i] = data[i];
+	}
+	UART_txHead = start + length;
+	UART_service();
+	return 1;
 }
 
-//! \brief Prints a string over using the Timer_A UART
+//! \brief Prints a string over the UART, waiting for room when the ring
+//!        buffer is full
 //! \param uint8_t * string - pointer to string to be printed
 //!
 void UART_print(uint8_t *string)
 {
     while (*string)
     {
-        UART_tx(*string++);
+        while (!UART_tx(*string))
+        {
+            UART_service();
+        }
+        string++;
     }
 }
 
-//! \brief UART interrupt service routine
+//! \brief Retires the block sent by the DMA and, once UCA0TXBUF is free,
+//!        starts the DMA on the next contiguous block of the ring buffer.
+//!        To be called from the main loop.
 //!
-void EUSCIA0_IRQHandler(void)
+void UART_service(void)
 {
-	if (UCA0IFG & UCTXIFG)
+	uint16_t length;
+
+	if (UART_txBlock)
 	{
-    	UCA0TXBUF = UART_txData;
-    	UCA0IE &= ~UCTXIE;               // Disable USCI_A0 TX interrupt until ready to send again
-    	while(!(UCA0IFG & UCTXCPTIFG));
-    }
+		if (MAP_DMA_isChannelEnabled(UART_TX_DMA_CHANNEL))
+		{
+			return;             // block still in progress
+		}
+		UART_txTail += UART_txBlock;
+		UART_txBlock = 0;
+	}
+	if (UART_txHead == UART_txTail)
+	{
+		UART_txHead = 0;        // empty: start again at the beginning
+		UART_txTail = 0;
+		return;
+	}
+	if ((UART_txHead < UART_txTail) && (UART_txTail == UART_txEnd))
+	{
+		UART_txTail = 0;        // bytes before the wrap sent
+	}
+	if (!(UCA0IFG & UCTXIFG))
+	{
+		return;                 // UCA0TXBUF still full
+	}
+
+	//Contiguous bytes up to the head or the end of the bytes before the wrap
+	if (UART_txHead > UART_txTail)
+	{
+		length = UART_txHead - UART_txTail;
+	}
+	else
+	{
+		length = UART_txEnd - UART_txTail;
+	}
+
+	MAP_DMA_setChannelTransfer(UDMA_PRI_SELECT | DMA_CH0_EUSCIA0TX,
+			UDMA_MODE_BASIC, &UART_txRing[UART_txTail],
+			(void *) &UCA0TXBUF, length);
+	MAP_DMA_enableChannel(UART_TX_DMA_CHANNEL);
+	UART_txBlock = length;
+}
+
+//! \brief Waits until all queued bytes have left the UART, e.g. before
+//!        SMCLK is changed
+//!
+void UART_flush(void)
+{
+	while (UART_txBlock || (UART_txHead != UART_txTail))
+	{
+		UART_service();
+	}
+	while (UCA0STATW & UCBUSY);
 }
-   
@@ -45,14 +45,20 @@
 #define UART_RXD   BIT2                     // RXD on P1.2
 
 //*******************************************************************************
-// external globals
+// UART settings
 //*******************************************************************************
-extern uint8_t UART_txData;
+#define UART_BAUD               9600        // baud rate
+#define UART_TX_RING_SIZE       32          // transmit buffer bytes
+#define UART_TX_DMA_CHANNEL     0           // DMA channel feeding UCA0TXBUF
 
 //*******************************************************************************
 // external functions
 //*******************************************************************************
-extern void UART_init(void);
+extern void UART_init(uint32_t smclkFrequency);
+extern void UART_setClock(uint32_t smclkFrequency);
 extern void UART_shutdown(void);
-extern void UART_tx(uint8_t byte);
+extern uint8_t UART_tx(uint8_t byte);
+extern uint8_t UART_write(const uint8_t *data, uint16_t length);
 extern void UART_print(uint8_t *string);
+extern void UART_service(void);
+extern void UART_flush(void);
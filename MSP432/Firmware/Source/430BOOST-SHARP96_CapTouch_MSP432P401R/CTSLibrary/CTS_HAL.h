@@ -60,11 +60,19 @@
 
 #include "structure.h"
 
-void TI_CTS_RO_CTIO_TA2_WDTA_HAL(const struct Sensor *,uint16_t *);
+void TI_CTS_RO_CTIO_TA2_WDTA_HAL(const struct Sensor *,cts_count_t *);
 
-void TI_CTS_RO_CTIO_TA2_TA3_HAL(const struct Sensor *,uint16_t *);
+void TI_CTS_RO_CTIO_TA2_TA3_HAL(const struct Sensor *,cts_count_t *);
 
-void TI_CTS_fRO_CTIO_TA2_TA3_HAL(const struct Sensor *,uint16_t *);
+void TI_CTS_fRO_CTIO_TA2_TA3_HAL(const struct Sensor *,cts_count_t *);
+
+#ifdef SMCLK_REFERENCE
+/*
+ *  Provided by the application: the SMCLK frequency in Hz at the time of
+ *  the measurement.
+ */
+uint32_t TI_CTS_Get_SMCLK(void);
+#endif
 
 
 #endif /* CTS_HAL_H_ */
@@ -82,6 +82,97 @@
 #define SENSOR_NUM 1                   //Only 1 channel needed to display wheel position
 #endif
 
+//! \brief Size of the UART transmit ring buffer in bytes.
+//!        Frames that do not fit while the previous ones drain are dropped
+//!        so that scanning never waits on the UART.
+//!
+#define TX_RING_SIZE 64
+
+//! \brief DMA channel feeding the eUSCI_A0 transmit buffer
+//!
+#define TX_DMA_CHANNEL 0
+
+//! \brief DMA channel emptying the eUSCI_A0 receive buffer
+//!
+#define RX_DMA_CHANNEL 1
+
+//! \brief Bytes per half of the receive buffer. The DMA fills the halves in
+//!        turn (ping-pong); a half is handed back to the DMA once read.
+//!
+#define RX_HALF_SIZE 32
+
+//! \brief Sync word sent before each tuning command and response
+//!
+#define TuneHead 0xA5C3
+
+//! \brief Bytes of a tuning command or response: TuneHead, operation,
+//!        parameter, index, value (2 bytes) and CRC-16 (2 bytes)
+//!
+#define TUNE_FRAME_SIZE 9
+
+//! \brief Tuning operations; a response carries the operation ORed with
+//!        TUNE_OK or TUNE_ERROR
+//!
+#define TUNE_READ 0x01
+#define TUNE_WRITE 0x02
+#define TUNE_OK 0x80
+#define TUNE_ERROR 0xC0
+
+//! \brief Tuning parameters; the index selects the element of the wheel
+//!        and is 0 for the parameters of the wheel itself
+//!
+#define TUNE_THRESHOLD 0x01
+#define TUNE_MAX_RESPONSE 0x02
+#define TUNE_RELEASE_THRESHOLD 0x03
+#define TUNE_ACCUMULATION_CYCLES 0x04
+#define TUNE_TRACKING_RATE 0x05
+
+#ifdef EXTENDED_COUNTS
+#error "Touch Pro frames carry 16-bit counts, undefine EXTENDED_COUNTS"
+#endif
+
+//! \brief SMCLK frequency set by System_config()
+//!
+#if (__SYSTEM_CLOCK == 48000000)
+#define SMCLK_FREQUENCY 24000000
+#elif (__SYSTEM_CLOCK == 24000000)
+#define SMCLK_FREQUENCY 3000000
+#else
+#define SMCLK_FREQUENCY 1000000
+#endif
+
+//! \brief SMCLK cycles per bit in 1/16, rounded
+//!
+#define UART_N16 ((16UL * SMCLK_FREQUENCY + UART_BAUD / 2) / UART_BAUD)
+#if (UART_N16 < 48)
+#error "UART_BAUD too high for SMCLK, select a higher __SYSTEM_CLOCK"
+#endif
+
+#if (FRAME_FORMAT == 2)
+//! \brief Sync word sent before each v2 frame
+//!
+#define DataHead2 0xA55A
+
+//! \brief A v2 key frame carrying the values of all channels is sent once
+//!        KEY_FRAME_INTERVAL samples have passed since the last one, also
+//!        when nothing changed, so that a receiver that starts mid-stream
+//!        or loses a frame resynchronizes
+//!
+#define KEY_FRAME_INTERVAL 64
+
+//! \brief Bytes of the v2 channel mask
+//!
+#define MASK_BYTES ((SENSOR_NUM + 7) / 8)
+
+//! \brief Offset of the channel mask in a v2 frame
+//!
+#define MASK_OFFSET 5
+#endif
+
+//! \brief MCLK cycles between samples
+//!
+#define SAMPLE_PERIOD (__SYSTEM_CLOCK / SAMPLE_RATE)
+
 //************************************************************************************************
 // Globals
 //************************************************************************************************
@@ -95,6 +186,68 @@ uint16_t CAPT_count[SENSOR_NUM];
 //!
 uint16_t CAPT_wheelPos;
 
+//! \brief Number of the current sample, counting Timer32 periods
+//!
+uint16_t SAMPLE_count;
+
+//! \brief Timer32 1 value at the start of the current sample period
+//!
+uint32_t SAMPLE_start;
+
+//! \brief UART transmit ring buffer. Bytes from UART_txTail up to UART_txHead
+//!        are queued; the DMA sends UART_txBlock of them starting at
+//!        UART_txTail. Each frame is stored in one piece: a frame that does
+//!        not fit before the end of the buffer starts at index 0, and
+//!        UART_txEnd marks where the bytes before the wrap end.
+//!
+uint8_t UART_txRing[TX_RING_SIZE];
+uint16_t UART_txHead;
+uint16_t UART_txTail;
+uint16_t UART_txEnd;
+uint16_t UART_txBlock;
+
+//! \brief UART receive buffer, two halves of RX_HALF_SIZE bytes filled by
+//!        the DMA. UART_rxRead is the next byte to read.
+//!
+uint8_t UART_rxBuffer[2 * RX_HALF_SIZE];
+uint16_t UART_rxRead;
+
+//! \brief Tuning command being received and its length so far
+//!
+uint8_t UART_command[TUNE_FRAME_SIZE];
+uint8_t UART_commandLength;
+
+//! \brief Tracking rate last set with TI_CAPT_Update_Tracking_Rate()
+//!
+uint16_t TUNE_trackingRate = TRADOI_FAST + TRIDOI_SLOW;
+
+//! \brief DMA control table, aligned to 1024 bytes as required by the DMA
+//!
+#if defined(__TI_COMPILER_VERSION__)
+#pragma DATA_ALIGN(UART_dmaControlTable, 1024)
+uint8_t UART_dmaControlTable[1024];
+#elif defined(__IAR_SYSTEMS_ICC__)
+#pragma data_alignment=1024
+uint8_t UART_dmaControlTable[1024];
+#else
+uint8_t UART_dmaControlTable[1024] __attribute__((aligned(1024)));
+#endif
+
+#if (FRAME_FORMAT == 2)
+//! \brief Channel values the receiver holds, i.e. those of the frames sent
+//!
+uint16_t UART_sentCount[SENSOR_NUM];
+
+//! \brief Sequence number of the next v2 frame, 0-127
+//!
+uint8_t UART_sequence;
+
+//! \brief SAMPLE_count of the last key frame sent, valid once UART_keySent
+//!
+uint16_t UART_keySample;
+uint8_t UART_keySent;
+#endif
+
 //************************************************************************************************
 // Function Prototypes
 //************************************************************************************************
@@ -103,17 +256,49 @@ uint16_t CAPT_wheelPos;
 //!
 void System_config(void);
 
-//! \brief Configures eUSCI module for TX only UART
+//! \brief Configures eUSCI module for UART
 //!
 void eUSCI_configUART(void);
 
-//! \brief Sends an entire Touch Data Packet to GUI via UART
+//! \brief Starts Timer32 0 with a period of 1/SAMPLE_RATE and Timer32 1
+//!        as the time reference of the sample count
+//!
+void Sample_configTimer(void);
+
+//! \brief Sleeps until the next sample is due
+//!
+void Sample_wait(void);
+
+//! \brief Queues an entire Touch Data Packet for the GUI
 //!
 void UART_sendTouchData(void);         // Cap Touch Display Data Logger
 
-//! \brief Sends a single data byte via UART using eUSCI module
+#if (FRAME_FORMAT == 2)
+//! \brief Queues a compact v2 frame of the channels that changed
 //!
-void UART_sendByte(uint8_t data2send);
+void UART_sendTouchDataV2(void);
+#endif
+
+//! \brief Updates a CRC-16/CCITT with one byte
+//!
+uint16_t CRC16_update(uint16_t crc, uint8_t data);
+
+//! \brief Reads the bytes received since the last call and executes the
+//!        tuning commands among them
+//!
+void UART_receive(void);
+
+//! \brief Executes a tuning command and queues the response
+//!
+void UART_tuneCommand(const uint8_t *command);
+
+//! \brief Queues a frame for transmission without waiting
+//!
+uint8_t UART_enqueueFrame(const uint8_t *frame, uint16_t length);
+
+//! \brief Starts the DMA on the next queued bytes when the UART is idle
+//!
+void UART_service(void);
 
 
 //! \brief Function initializes and updates baseline for wheel and monitors the changes in capacitance to
@@ -127,7 +312,7 @@ void main(void) {
 	//Setup system clocks
     System_config();
 
-    // Initialize UART Communication at 9600 Baud (P1.3)
+    // Initialize UART Communication at UART_BAUD (P1.3)
 	eUSCI_configUART();
 
 	//Calculate baseline
@@ -135,10 +320,19 @@ void main(void) {
 	//Update the baseline
 	TI_CAPT_Update_Baseline(&wheel,50);
 
+	//Start the sample clock
+	Sample_configTimer();
+
 	//Continuously update element or sensor data
 	// and send new data to Touch Pro GUI via UART
 	while(1)
 	{
+		//Sleep until the next sample period begins
+		Sample_wait();
+
+		//Apply tuning commands received from the host before the scan
+		UART_receive();
+
 #ifdef Custom_Counts
 		//API call that records the current element counts
 		// based on changes in capacitance
@@ -156,14 +350,12 @@ void main(void) {
 		//Stores wheel position in data array
 		CAPT_count[channelIndex] = CAPT_wheelPos;
 #endif
-		//Cap Touch Display Data Logger Call
+		//Cap Touch Display Data Logger Call, the frame drains while
+		// the next scan runs
+#if (FRAME_FORMAT == 2)
+		UART_sendTouchDataV2();
+#else
 		UART_sendTouchData();
-
-#if (__SYSTEM_CLOCK == CS_48MHZ)
-		// Delay between sending data if system clock too high to avoid
-		// lag on Touch Pro GUI
-		uint32_t i;
-		for(i=0;i<50000;i++);
 #endif
 		// Toggle LED1
 		P1OUT ^= BIT0;
@@ -252,14 +444,79 @@ void System_config(void)
 	P1DIR |= BIT0;
 }
 
+//! \brief Timer32 0 runs from MCLK in periodic mode. Its interrupt is
+//!        enabled in the module but not in the NVIC: the pending interrupt
+//!        wakes Sample_wait() through SEVONPEND without ending the LPM0
+//!        waits of the Capacitive Touch HAL during a measurement.
+//!        Timer32 1 runs free from MCLK, started just before Timer32 0, so
+//!        that Sample_wait() can tell how many periods have passed; it
+//!        wraps after 2^32 MCLK cycles, far longer than any sample.
+//!
+void Sample_configTimer(void)
+{
+	MAP_Timer32_initModule(TIMER32_0_BASE, TIMER32_PRESCALER_1, TIMER32_32BIT,
+			TIMER32_PERIODIC_MODE);
+	MAP_Timer32_setCount(TIMER32_0_BASE, SAMPLE_PERIOD);
+	MAP_Timer32_enableInterrupt(TIMER32_0_BASE);
+	MAP_Interrupt_disableInterrupt(TIMER32_0_INTERRUPT);
+
+	MAP_Timer32_initModule(TIMER32_1_BASE, TIMER32_PRESCALER_1, TIMER32_32BIT,
+			TIMER32_FREE_RUN_MODE);
+	MAP_Timer32_setCount(TIMER32_1_BASE, 0xFFFFFFFF);
+
+	// Pending interrupts, including disabled ones, wake the CPU from WFE
+	SCB->SCR |= SCB_SCR_SEVONPEND_Msk;
+
+	MAP_Timer32_startTimer(TIMER32_1_BASE, false);
+	SAMPLE_start = MAP_Timer32_getValue(TIMER32_1_BASE);
+	MAP_Timer32_startTimer(TIMER32_0_BASE, false);
+}
+
+//! \brief Waits in LPM0 for the end of the Timer32 period. If the previous
+//!        sample took longer than a period, the next one starts at once and
+//!        SAMPLE_count advances by the number of periods that have passed,
+//!        so that the receiver sees which samples were skipped.
+//!
+void Sample_wait(void)
+{
+	uint32_t periods;
+
+	do
+	{
+		while (!MAP_Timer32_getInterruptStatus(TIMER32_0_BASE))
+		{
+			// Start the next queued block before sleeping; an event from
+			// another interrupt only repeats the check
+			UART_service();
+			__WFE();
+		}
+		MAP_Timer32_clearInterruptFlag(TIMER32_0_BASE);
+		MAP_Interrupt_unpendInterrupt(TIMER32_0_INTERRUPT);
+
+		// Timer32 1 counts down; SAMPLE_start lies just before a period
+		// start of Timer32 0, so the quotient is the number of periods that
+		// ended. 0 means the flag was set by a period already counted.
+		periods = (SAMPLE_start - MAP_Timer32_getValue(TIMER32_1_BASE))
+				/ SAMPLE_PERIOD;
+	} while (periods == 0);
+	SAMPLE_start -= periods * SAMPLE_PERIOD;
+	SAMPLE_count += (uint16_t) periods;
+}
+
 //! \brief USCIA - USCI Module Configuration for UART
-//!                TX ONLY!
 //!                Note: Requires device with USCI
 //!
 void eUSCI_configUART(void)
 {
-	// Setup DIO pin 1.3 w/ UART Tx function
-	P1SEL0 |= BIT3;
+#if (UART_BAUD != 9600)
+	// UCBRSx for the fractional part of SMCLK/UART_BAUD in 1/16
+	static const uint8_t brs[16] = {
+		0x00, 0x01, 0x08, 0x11, 0x22, 0x25, 0x4A, 0x53,
+		0x55, 0xAA, 0xAD, 0xD6, 0xBB, 0xEE, 0xEF, 0xFE };
+#endif
+
+	// Setup DIO pins 1.2 and 1.3 w/ UART Rx and Tx function
+	P1SEL0 |= BIT2 | BIT3;
 
 	// Put eUSCI in reset
 	UCA0CTLW0 |= UCSWRST;
@@ -267,7 +524,19 @@ void eUSCI_configUART(void)
 	UCA0CTLW0 |= UCSSEL__SMCLK;
 
 	// Baud Rate calculation
-#if (__SYSTEM_CLOCK == 24000000)
+#if (UART_BAUD != 9600)
+#if (UART_N16 >= 256)
+	// Oversampling: UCBRx = INT(N/16), UCBRFx = INT(FRAC(N/16)*16)
+	UCA0BR0 = (uint8_t) (UART_N16 / 256);
+	UCA0BR1 = (uint8_t) (UART_N16 / 65536);
+	UCA0MCTLW = (brs[UART_N16 % 16] << 8) | (((UART_N16 / 16) % 16) << 4) | UCOS16;
+#else
+	// Low frequency mode: UCBRx = INT(N)
+	UCA0BR0 = (uint8_t) (UART_N16 / 16);
+	UCA0BR1 = 0x00;
+	UCA0MCTLW = (brs[UART_N16 % 16] << 8);
+#endif
+#elif (__SYSTEM_CLOCK == 24000000)
 	UCA0BR0 = 19;                    // 3000000/9600/16
 	UCA0BR1 = 0x00;
 	UCA0MCTLW = 0x5500 | UCOS16 | 0x0080;
@@ -285,6 +554,38 @@ void eUSCI_configUART(void)
 	UCA0CTLW0 &= ~(UCMSB);
 	// Initialize eUSCI
 	UCA0CTLW0 &= ~UCSWRST;
+
+	// The DMA moves queued bytes into UCA0TXBUF on each UCTXIFG. No
+	// interrupt is used: an interrupt would end the low power mode of a
+	// capacitive touch measurement early.
+	MAP_DMA_enableModule();
+	MAP_DMA_setControlBase(UART_dmaControlTable);
+	MAP_DMA_assignChannel(DMA_CH0_EUSCIA0TX);
+	MAP_DMA_disableChannelAttribute(DMA_CH0_EUSCIA0TX, UDMA_ATTR_ALL);
+	MAP_DMA_setChannelControl(UDMA_PRI_SELECT | DMA_CH0_EUSCIA0TX,
+			UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE | UDMA_ARB_1);
+	UART_txHead = 0;
+	UART_txTail = 0;
+	UART_txEnd = 0;
+	UART_txBlock = 0;
+
+	// The DMA also moves each received byte from UCA0RXBUF into the halves
+	// of UART_rxBuffer in turn
+	MAP_DMA_assignChannel(DMA_CH1_EUSCIA0RX);
+	MAP_DMA_disableChannelAttribute(DMA_CH1_EUSCIA0RX, UDMA_ATTR_ALL);
+	MAP_DMA_setChannelControl(UDMA_PRI_SELECT | DMA_CH1_EUSCIA0RX,
+			UDMA_SIZE_8 | UDMA_SRC_INC_NONE | UDMA_DST_INC_8 | UDMA_ARB_1);
+	MAP_DMA_setChannelControl(UDMA_ALT_SELECT | DMA_CH1_EUSCIA0RX,
+			UDMA_SIZE_8 | UDMA_SRC_INC_NONE | UDMA_DST_INC_8 | UDMA_ARB_1);
+	MAP_DMA_setChannelTransfer(UDMA_PRI_SELECT | DMA_CH1_EUSCIA0RX,
+			UDMA_MODE_PINGPONG, (void *) &UCA0RXBUF, &UART_rxBuffer[0],
+			RX_HALF_SIZE);
+	MAP_DMA_setChannelTransfer(UDMA_ALT_SELECT | DMA_CH1_EUSCIA0RX,
+			UDMA_MODE_PINGPONG, (void *) &UCA0RXBUF,
+			&UART_rxBuffer[RX_HALF_SIZE], RX_HALF_SIZE);
+	MAP_DMA_enableChannel(RX_DMA_CHANNEL);
+	UART_rxRead = 0;
+	UART_commandLength = 0;
 }
 
 //! \brief Function calculates data length and check sum. This is the
@@ -293,58 +594,412 @@ void eUSCI_configUART(void)
 void UART_sendTouchData(void)
 {
 	uint8_t i = 0;
-	uint16_t temp = 0;
-	uint8_t data_length = 0;
+	uint8_t frame[3 + SENSOR_NUM * 3 + 1];
+	uint8_t length = 0;
 	uint8_t check_sum = 0;
 
+	//Store high and low byte of DataHead
+	frame[length++] = (uint8_t) (DataHead >> 8);
+	frame[length++] = (uint8_t) DataHead;
+
 	//# of channels *3 + 1 (checksum)
 	//1 byte for the channel number, 1 byte for high order data byte
 	//and 3rd byte is for low order byte.  The plus 1 is for checksum byte.
-	data_length = SENSOR_NUM * 3  + 1;
+	frame[length++] = SENSOR_NUM * 3  + 1;
+
+	for (i = 0; i < SENSOR_NUM; i++)
+	{
+		//Store data index, high byte and low byte of data
+		frame[length++] = i + 1;
+		frame[length++] = (uint8_t) (CAPT_count[i] >> 8);
+		frame[length++] = (uint8_t) CAPT_count[i];
+	}
 
-	//Store and send high byte of DataHead
-	temp = DataHead;
-	temp >>= 8;
-	UART_sendByte((uint8_t) temp);
-	check_sum = (uint8_t) temp;
+	//Store check sum
+	for (i = 0; i < length; i++)
+	{
+		check_sum += frame[i];
+	}
+	frame[length++] = check_sum;
 
-	//Send low byte of DataHead
-	UART_sendByte((uint8_t) DataHead);
-	check_sum += (uint8_t) DataHead;
+	UART_enqueueFrame(frame, length);
+}
 
-	//Send data payload length
-	UART_sendByte(data_length);
-	check_sum += data_length;
+#if (FRAME_FORMAT == 2)
+//! \brief Queues a compact v2 frame. Format:
+//!          DataHead2 (2 bytes, high byte first)
+//!          control: bit 7 key frame, bits 6-0 sequence number
+//!          SAMPLE_count (2 bytes, high byte first)
+//!          channel mask, MASK_BYTES bytes, bit i of byte i/8 set when
+//!           channel i+1 follows
+//!          for each channel in the mask, in channel order, a LEB128 varint:
+//!           key frame: the value; otherwise the zigzag encoded difference
+//!           to the value of the channel in the previous frame
+//!          CRC-16/CCITT (polynomial 0x1021, seed 0xFFFF) of the control
+//!           byte through the last varint, high byte first
+//!        Frames without changes are not sent, except for the key frames
+//!        due every KEY_FRAME_INTERVAL samples; the sample count tells the
+//!        receiver which samples are missing and when each frame was
+//!        taken. Frames dropped because the ring buffer is full do not
+//!        advance the sequence number or the values the deltas refer to, so
+//!        the receiver stays in sync; after a sequence gap it waits for the
+//!        next key frame.
+//!
+void UART_sendTouchDataV2(void)
+{
+	uint8_t frame[MASK_OFFSET + MASK_BYTES + SENSOR_NUM * 3 + 2];
+	uint8_t length;
+	uint8_t i;
+	uint8_t key = !UART_keySent
+			|| ((uint16_t) (SAMPLE_count - UART_keySample) >= KEY_FRAME_INTERVAL);
+	uint16_t crc = 0xFFFF;
+	uint32_t value;
+	int32_t delta;
+
+	frame[0] = (uint8_t) (DataHead2 >> 8);
+	frame[1] = (uint8_t) DataHead2;
+	frame[2] = (key ? 0x80 : 0x00) | UART_sequence;
+	frame[3] = (uint8_t) (SAMPLE_count >> 8);
+	frame[4] = (uint8_t) SAMPLE_count;
+	length = MASK_OFFSET + MASK_BYTES;
+	for (i = 0; i < MASK_BYTES; i++)
+	{
+		frame[MASK_OFFSET + i] = 0;
+	}
 
 	for (i = 0; i < SENSOR_NUM; i++)
 	{
-		//Send data index
-		UART_sendByte(i + 1);
-		check_sum += (i + 1);
-
-		//Store and send high byte of data
-		temp = CAPT_count[i];
-		temp >>= 8;
-		UART_sendByte((uint8_t) temp);
-		check_sum += (uint8_t) temp;
-
-		//Send low byte
-		UART_sendByte((uint8_t) CAPT_count[i]);
-		check_sum += (uint8_t) CAPT_count[i];
+		if (key)
+		{
+			value = CAPT_count[i];
+		}
+		else if (CAPT_count[i] != UART_sentCount[i])
+		{
+			//zigzag: small differences of either sign give small values
+			delta = (int32_t) CAPT_count[i] - (int32_t) UART_sentCount[i];
+			value = ((uint32_t) delta << 1) ^ (uint32_t) (delta >> 31);
+		}
+		else
+		{
+			continue;
+		}
+		frame[MASK_OFFSET + i / 8] |= 1 << (i % 8);
+		while (value >= 0x80)
+		{
+			frame[length++] = (uint8_t) (value | 0x80);
+			value >>= 7;
+		}
+		frame[length++] = (uint8_t) value;
+	}
+
+	if (!key && (length == MASK_OFFSET + MASK_BYTES))
+	{
+		return;                             // nothing changed
+	}
+	for (i = 2; i < length; i++)
+	{
+		crc = CRC16_update(crc, frame[i]);
+	}
+	frame[length++] = (uint8_t) (crc >> 8);
+	frame[length++] = (uint8_t) crc;
+
+	if (UART_enqueueFrame(frame, length))
+	{
+		for (i = 0; i < SENSOR_NUM; i++)
+		{
+			UART_sentCount[i] = CAPT_count[i];
+		}
+		UART_sequence = (UART_sequence + 1) & 0x7F;
+		if (key)
+		{
+			UART_keySample = SAMPLE_count;
+			UART_keySent = 1;
+		}
+	}
+}
+#endif
+
+//! \brief CRC-16/CCITT, MSB first, polynomial 0x1021
+//! \param uint16_t crc - CRC of the preceding bytes
+//! \param uint8_t data - next byte
+//! \return CRC including data
+//!
+uint16_t CRC16_update(uint16_t crc, uint8_t data)
+{
+	uint8_t bit;
+
+	crc ^= (uint16_t) data << 8;
+	for (bit = 0; bit < 8; bit++)
+	{
+		if (crc & 0x8000)
+		{
+			crc = (crc << 1) ^ 0x1021;
+		}
+		else
+		{
+			crc <<= 1;
+		}
+	}
+	return crc;
+}
+
+//! \brief Copies a frame into the transmit ring buffer and starts sending it
+//!        if the UART is idle. Does not wait.
+//! \param const uint8_t *frame - bytes of the frame
+//! \param uint16_t length - number of bytes in the frame
+//! \return 1 if the frame was queued, 0 if it was dropped for lack of room
+//!
+uint8_t UART_enqueueFrame(const uint8_t *frame, uint16_t length)
+{
+	uint16_t start;
+	uint16_t i;
+
+	UART_service();
+	if (UART_txHead >= UART_txTail)
+	{
+		// Free: from the head to the end, then from 0 up to the tail
+		if (UART_txHead + length <= TX_RING_SIZE)
+		{
+			start = UART_txHead;
+		}
+		else if (length < UART_txTail)
+		{
+			UART_txEnd = UART_txHead;
+			start = 0;
+		}
+		else
+		{
+			return 0;
+		}
+	}
+	else if (UART_txHead + length < UART_txTail)
+	{
+		start = UART_txHead;
+	}
+	else
+	{
+		return 0;
+	}
+	for (i = 0; i < length; i++)
+	{
+		UART_txRing[start + i] = frame[i];
+	}
+	UART_txHead = start + length;
+	UART_service();
+	return 1;
+}
+
+//! \brief Retires the block sent by the DMA and, once UCA0TXBUF is free,
+//!        starts the DMA on the next contiguous block of the ring buffer.
+//!        Called through UART_enqueueFrame() and from Sample_wait().
+//!
+void UART_service(void)
+{
+	uint16_t length;
+
+	if (UART_txBlock)
+	{
+		if (MAP_DMA_isChannelEnabled(TX_DMA_CHANNEL))
+		{
+			return;             // block still in progress
+		}
+		UART_txTail += UART_txBlock;
+		UART_txBlock = 0;
+	}
+	if (UART_txHead == UART_txTail)
+	{
+		UART_txHead = 0;        // empty: start again at the beginning
+		UART_txTail = 0;
+		return;
+	}
+	if ((UART_txHead < UART_txTail) && (UART_txTail == UART_txEnd))
+	{
+		UART_txTail = 0;        // bytes before the wrap sent
+	}
+	if (!(UCA0IFG & UCTXIFG))
+	{
+		return;                 // UCA0TXBUF still full
 	}
 
-	//Send check sum
-	UART_sendByte((uint8_t) check_sum);
+	//Contiguous bytes up to the head or the end of the bytes before the wrap
+	if (UART_txHead > UART_txTail)
+	{
+		length = UART_txHead - UART_txTail;
+	}
+	else
+	{
+		length = UART_txEnd - UART_txTail;
+	}
+
+	MAP_DMA_setChannelTransfer(UDMA_PRI_SELECT | DMA_CH0_EUSCIA0TX,
+			UDMA_MODE_BASIC, &UART_txRing[UART_txTail],
+			(void *) &UCA0TXBUF, length);
+	MAP_DMA_enableChannel(TX_DMA_CHANNEL);
+	UART_txBlock = length;
 }
 
-//!	\brief USCIA - UART TX Function
-//!    	   Note: Requires device with USCI
-//! \param unsigned char data2send - byte of data to transmit
+//! \brief Reads the bytes the DMA has stored since the last call, starting
+//!        at UART_rxRead. A completely read half is set up again for the
+//!        DMA to fill after the other half. The host waits for the response
+//!        to each command, so a half never fills up before it is read.
 //!
-void UART_sendByte(uint8_t data2send)
+void UART_receive(void)
 {
-	//Wait for any previous transfer to complete
-	while(!(UCA0IFG & UCTXIFG));
-	//Load data into transmit buffer
-	UCA0TXBUF = data2send;
+	uint16_t half;
+	uint16_t end;
+	uint32_t select;
+	uint8_t done;
+	uint8_t byte;
+
+	while (1)
+	{
+		half = UART_rxRead / RX_HALF_SIZE;
+		select = (half ? UDMA_ALT_SELECT : UDMA_PRI_SELECT) | DMA_CH1_EUSCIA0RX;
+
+		//The mode is read first: a half found unfinished is read up to the
+		// bytes transferred so far and finished on a later call
+		done = (MAP_DMA_getChannelMode(select) == UDMA_MODE_STOP);
+		end = (half + 1) * RX_HALF_SIZE - (done ? 0 : MAP_DMA_getChannelSize(select));
+
+		while (UART_rxRead < end)
+		{
+			byte = UART_rxBuffer[UART_rxRead++];
+
+			//Collect a command, restarting on each new TuneHead
+			if ((UART_commandLength == 0 && byte != (uint8_t) (TuneHead >> 8))
+					|| (UART_commandLength == 1 && byte != (uint8_t) TuneHead))
+			{
+				UART_commandLength = (byte == (uint8_t) (TuneHead >> 8));
+				continue;
+			}
+			UART_command[UART_commandLength++] = byte;
+			if (UART_commandLength == TUNE_FRAME_SIZE)
+			{
+				UART_tuneCommand(UART_command);
+				UART_commandLength = 0;
+			}
+		}
+		if (!done)
+		{
+			break;
+		}
+
+		MAP_DMA_setChannelTransfer(select, UDMA_MODE_PINGPONG,
+				(void *) &UCA0RXBUF, &UART_rxBuffer[half * RX_HALF_SIZE],
+				RX_HALF_SIZE);
+		UART_rxRead %= 2 * RX_HALF_SIZE;
+	}
+
+	//Both halves filled before they were read: the DMA stopped, restart it
+	// on the first half
+	if (!MAP_DMA_isChannelEnabled(RX_DMA_CHANNEL))
+	{
+		MAP_DMA_enableChannel(RX_DMA_CHANNEL);
+	}
+}
+
+//! \brief Executes a tuning command received from the host. Commands with a
+//!        wrong CRC are ignored; the host repeats a command until it gets
+//!        the response. Writes take effect at the next scan; a new gate
+//!        time also measures the baseline again. Command and response:
+//!          TuneHead (2 bytes, high byte first)
+//!          operation: TUNE_READ or TUNE_WRITE, in the response ORed with
+//!           TUNE_OK, or TUNE_ERROR for an unknown parameter or index
+//!          parameter: TUNE_THRESHOLD, TUNE_MAX_RESPONSE,
+//!           TUNE_RELEASE_THRESHOLD (with ELEMENT_HYSTERESIS),
+//!           TUNE_ACCUMULATION_CYCLES or TUNE_TRACKING_RATE (TRIDOI and
+//!           TRADOI bits of ctsStatusReg)
+//!          index: element of the wheel, 0 for the wheel parameters
+//!          value (2 bytes, high byte first): the value to write; in the
+//!           response the current value
+//!          CRC-16/CCITT (polynomial 0x1021, seed 0xFFFF) of the operation
+//!           through the value, high byte first
+//! \param const uint8_t *command - the command, TuneHead first
+//!
+void UART_tuneCommand(const uint8_t *command)
+{
+	uint8_t response[TUNE_FRAME_SIZE];
+	uint8_t operation = command[2];
+	uint8_t parameter = command[3];
+	uint8_t index = command[4];
+	uint16_t value = ((uint16_t) command[5] << 8) | command[6];
+	uint16_t crc = 0xFFFF;
+	uint16_t current = 0;
+	uint16_t *field = 0;
+	struct Element *element = 0;
+	uint8_t i;
+
+	for (i = 2; i < 7; i++)
+	{
+		crc = CRC16_update(crc, command[i]);
+	}
+	if (crc != (((uint16_t) command[7] << 8) | command[8]))
+	{
+		return;
+	}
+
+	if (index < wheel.numElements)
+	{
+		element = (struct Element *) wheel.arrayPtr[index];
+	}
+	switch (parameter)
+	{
+	case TUNE_THRESHOLD:
+		field = element ? &element->threshold : 0;
+		break;
+	case TUNE_MAX_RESPONSE:
+		field = element ? &element->maxResponse : 0;
+		break;
+#ifdef ELEMENT_HYSTERESIS
+	case TUNE_RELEASE_THRESHOLD:
+		field = element ? &element->releaseThreshold : 0;
+		break;
+#endif
+	case TUNE_ACCUMULATION_CYCLES:
+		field = (index == 0) ? &wheel.accumulationCycles : 0;
+		break;
+	case TUNE_TRACKING_RATE:
+		field = (index == 0) ? &TUNE_trackingRate : 0;
+		value &= TRIDOI_FAST + TRADOI_VSLOW;
+		break;
+	}
+	if (field && (operation == TUNE_READ || operation == TUNE_WRITE))
+	{
+		if ((operation == TUNE_WRITE) && (*field != value))
+		{
+			*field = value;
+			if (parameter == TUNE_ACCUMULATION_CYCLES)
+			{
+				//Counts scale with the gate time
+				TI_CAPT_Init_Baseline(&wheel);
+				TI_CAPT_Update_Baseline(&wheel,50);
+			}
+			else if (parameter == TUNE_TRACKING_RATE)
+			{
+				TI_CAPT_Update_Tracking_Rate((uint8_t) value);
+			}
+		}
+		current = *field;
+		operation |= TUNE_OK;
+	}
+	else
+	{
+		operation |= TUNE_ERROR;
+	}
+
+	response[0] = (uint8_t) (TuneHead >> 8);
+	response[1] = (uint8_t) TuneHead;
+	response[2] = operation;
+	response[3] = parameter;
+	response[4] = index;
+	response[5] = (uint8_t) (current >> 8);
+	response[6] = (uint8_t) current;
+	crc = 0xFFFF;
+	for (i = 2; i < 7; i++)
+	{
+		crc = CRC16_update(crc, response[i]);
+	}
+	response[7] = (uint8_t) (crc >> 8);
+	response[8] = (uint8_t) crc;
+	UART_enqueueFrame(response, TUNE_FRAME_SIZE);
 }
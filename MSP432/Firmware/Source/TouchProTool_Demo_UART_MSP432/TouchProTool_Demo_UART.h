@@ -52,4 +52,24 @@
 //!
 #define Custom_Counts
 
+//! \brief UART baud rate. Rates other than 9600 are derived from SMCLK and
+//!        need at least 3 SMCLK cycles per bit, e.g. 1000000 requires the
+//!        48 MHz system clock (24 MHz SMCLK).
+//!         VALID VALUES: 9600, 115200, 460800, 1000000, ...
+//!
+#define UART_BAUD	9600
+
+//! \brief Frame format sent over the UART
+//!         1: Touch Pro GUI format, all channels as 16-bit values
+//!         2: compact format, changed channels as delta-encoded varints
+//!            with sequence number and CRC-16 (see UART_sendTouchDataV2)
+//!
+#define FRAME_FORMAT	1
+
+//! \brief Samples per second. Timer32 0 starts each sample and the CPU
+//!        sleeps in between; scanning and queuing a frame must take less
+//!        than 1/SAMPLE_RATE s.
+//!
+#define SAMPLE_RATE	50
+
 #endif /* TOUCHPROTOOL_DEMO_UART_H_ */
@@ -41,10 +41,13 @@
 #include "structure.h"
 #include "TouchProTool_Demo_UART.h"    //Contains definitions that impact sensor configuration
 
+// The elements and the wheel are not const: UART_tuneCommand() changes their
+// thresholds and gate time at run time
+
 //! \brief Struct containing definitions for Volume/Down
 //!        element (connected to P6.4)
 //!
-const struct Element down = {
+struct Element down = {
 
 		// Select pin P6.4
 		.inputBits = CAPTIOPOSEL_6 + CAPTIOPISEL_4,
@@ -84,7 +87,7 @@ const struct Element down = {
 //! \brief Struct containing definitions for Forward/Right
 //!        element (connected to P3.6)
 //!
-const struct Element right = {
+struct Element right = {
 
 		// Select Pin 3.6
 		.inputBits = CAPTIOPOSEL_3 + CAPTIOPISEL_6,
@@ -124,7 +127,7 @@ const struct Element right = {
 //! \brief Struct containing definitions for Volume/Up
 //!        element (connected to P5.2)
 //!
-const struct Element up = {
+struct Element up = {
 
 		// Select P5.2
 		.inputBits = CAPTIOPOSEL_5 + CAPTIOPISEL_2,
@@ -164,7 +167,7 @@ const struct Element up = {
 //! \brief Struct containing definitions for Reverse/Left
 //!        element (connected to P6.5)
 //!
-const struct Element left = {
+struct Element left = {
 
 		// Select P6.5
 		.inputBits = CAPTIOPOSEL_6 + CAPTIOPISEL_5,
@@ -206,7 +209,7 @@ const struct Element left = {
 //! \brief This defines the grouping of sensors, the method to measure change in
 //!        capacitance, and the function of the group
 //!
-const struct Sensor wheel =	{
+struct Sensor wheel =	{
 
 		//Set .halDefinition based on hardware configuration
 		// selected in structure.h
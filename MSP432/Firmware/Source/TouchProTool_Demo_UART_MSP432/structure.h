@@ -49,12 +49,12 @@
 #include <stdint.h>
 
 /* Public Globals */
-extern const struct Element volume_down;   // Element of slider wheel
-extern const struct Element volume_up;     // Element of slider wheel
-extern const struct Element right;         // Element of slider wheel
-extern const struct Element left;          // Element of slider wheel
+extern struct Element volume_down;         // Element of slider wheel
+extern struct Element volume_up;           // Element of slider wheel
+extern struct Element right;               // Element of slider wheel
+extern struct Element left;                // Element of slider wheel
 
-extern const struct Sensor wheel;          // Struct that contains element references and sensor configuration info
+extern struct Sensor wheel;                // Struct that contains element references and sensor configuration info
 
 //****** RAM ALLOCATION ********************************************************
 // TOTAL_NUMBER_OF_ELEMENTS defines the total number of elements used, even if
@@ -90,6 +90,108 @@ extern const struct Sensor wheel;          // Struct that contains element refer
 #define ILLEGAL_SLIDER_WHEEL_POSITION		0xFFFF
 #define WHEEL
 
+//****** MATRIX ****************************************************************
+// Are row/column matrix keypads used?  A keypad is described by one sensor of
+// row electrodes and one sensor of column electrodes, TI_CAPT_Matrix() returns
+// the key at the intersection.
+//#define MATRIX
+#define ILLEGAL_MATRIX_KEY                  0xFFFF
+
+//****** TOUCHPAD **************************************************************
+// Are touchpads used?  A touchpad is described by one sensor of X electrodes
+// and one sensor of Y electrodes, each with points and sensorThreshold like a
+// slider.  TI_CAPT_Touchpad() returns the X/Y position and the touch size.
+//#define TOUCHPAD
+
+//****** POSITION TRACKING *****************************************************
+// Smooth slider and wheel positions with a fixed-point alpha-beta filter, see
+// TI_CAPT_Tracked_Slider() and TI_CAPT_Tracked_Wheel().  The gains are in
+// 1/256, TRACKING_LEAD is the number of scans the output is predicted ahead to
+// compensate the lag of the filter.
+//#define POSITION_TRACKING
+#define TRACKING_ALPHA                      128
+#define TRACKING_BETA                       32
+#define TRACKING_LEAD                       1
+
+//****** SLIDER LUT ************************************************************
+// Linearize slider and wheel positions with a per-sensor correction table of
+// points+1 entries in RAM, referenced by positionLut of the sensor and filled
+// by TI_CAPT_Calibrate_Position_Lut() or, for a wheel,
+// TI_CAPT_Calibrate_Wheel_Lut() from a calibration sweep.
+//#define SLIDER_LUT
+
+//****** ROI SCAN **************************************************************
+// While a touch is tracked by TI_CAPT_Roi_Buttons(), TI_CAPT_Roi_Slider() or
+// TI_CAPT_Roi_Wheel() only the ROI_RADIUS elements on each side of the last
+// dominant element are measured.  Every ROI_FULL_SCAN_INTERVAL+1 scans all
+// elements are measured to refresh the baselines and to catch new touches.
+//#define ROI_SCAN
+#define ROI_RADIUS                          1
+#define ROI_FULL_SCAN_INTERVAL              8
+
+//****** SIMD CUSTOM ***********************************************************
+// Compute the deltas and baseline updates of TI_CAPT_Custom() for two elements
+// at a time with the packed halfword (DSP) instructions of the Cortex-M4.
+// Compilers without __ARM_FEATURE_DSP use a C version with identical results.
+// Requires 16-bit counts (no EXTENDED_COUNTS).
+//#define SIMD_CUSTOM
+
+//****** SENSOR CALLBACKS ******************************************************
+// Call application functions on press, release and position changes of
+// buttons, sliders and wheels from TI_CAPT_Buttons(), TI_CAPT_Slider() and
+// TI_CAPT_Wheel(), see TI_CAPT_Register_Callbacks().  CALLBACK_SENSORS is the
+// number of sensors that can be registered.
+//#define SENSOR_CALLBACKS
+#define CALLBACK_SENSORS                    4
+
+//****** STUCK TOUCH RECOVERY **************************************************
+// Re-baseline an element that stays above its threshold for STUCK_TOUCH_SCANS
+// consecutive scans (an object resting on the electrode or a corrupted
+// baseline) over its next RECOVERY_SCANS scans, without blocking and without
+// affecting the other elements.  See also TI_CAPT_Recover_Baseline().
+//#define STUCK_TOUCH_RECOVERY
+#define STUCK_TOUCH_SCANS                   1000
+#define RECOVERY_SCANS                      4
+
+//****** ELEMENT HYSTERESIS ****************************************************
+// Give elements a releaseThreshold, below threshold: a touch starts when the
+// delta reaches threshold and ends when it falls below releaseThreshold, so a
+// touch near the threshold does not toggle on consecutive scans.  Elements
+// with a releaseThreshold of 0 use threshold for both.
+//#define ELEMENT_HYSTERESIS
+
+//****** SMCLK REFERENCE *******************************************************
+// accumulationCycles of gates counted on SMCLK (measGateSource TIMER_SMCLK with
+// RO_CTIO_TA2_TA3) are given for an SMCLK of SMCLK_REFERENCE Hz.  The HAL
+// scales them with the SMCLK frequency returned by TI_CTS_Get_SMCLK(), which
+// the application provides, so the gate time does not change with the clock
+// setting.  WDTA gates and the fRO measurement timer are not scaled.
+//#define SMCLK_REFERENCE                     1000000
+
+//****** EXTENDED COUNTS *******************************************************
+// Extend measurement counts to 32 bits with the overflow interrupt of the
+// measurement timer instead of discarding measurements that exceed 16 bits.
+// This allows longer gate times (proximity sensing), at the cost of 32-bit
+// baseline RAM.  The TAx_N interrupt of the measurement timer is then owned by
+// the library.
+//#define EXTENDED_COUNTS
+
+//****** ELEMENT GATE **********************************************************
+// Allow each element to override the accumulationCycles (gate) of its sensor
+// so that large and small electrodes within one group are each measured with
+// the gate they need.  An element accumulationCycles of 0 uses the sensor
+// setting; with WDT gates the longest interval (select value 0) can therefore
+// only be chosen per sensor.
+//#define ELEMENT_GATE
+
+//****** FLEXIBLE ELEMENT ARRAY ************************************************
+// Let arrayPtr of each sensor point to an array of exactly numElements element
+// pointers instead of reserving MAXIMUM_NUMBER_OF_ELEMENTS_PER_SENSOR pointers
+// within every sensor.  The array is defined in structure.c, for example:
+//    const struct Element *const wheelElements[] = {&e0, &e1, &e2, &e3};
+//    const struct Sensor wheel = { ... .arrayPtr = wheelElements, ... };
+//#define FLEXIBLE_ELEMENT_ARRAY
+
 //******************************************************************************
 // End of user configuration section.
 //******************************************************************************
@@ -131,6 +233,9 @@ extern const struct Sensor wheel;          // Struct that contains element refer
     #define RO_TYPE
     #define WDT_GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #define TIMERA2_NOVERFLOW
+    #endif
 #endif
 
 #ifdef RO_CTIO_TA2_TA3
@@ -138,6 +243,9 @@ extern const struct Sensor wheel;          // Struct that contains element refer
     #define TIMER_SCALE
     #define TIMERA3_0GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #define TIMERA2_NOVERFLOW
+    #endif
 #endif
 
 #ifdef fRO_CTIO_TA2_TA3
@@ -145,6 +253,9 @@ extern const struct Sensor wheel;          // Struct that contains element refer
     #define TIMER_SCALE
     #define TIMERA2_0GATE
     #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #define TIMERA3_NOVERFLOW
+    #endif
 #endif
 
 
@@ -156,8 +267,32 @@ extern const struct Sensor wheel;          // Struct that contains element refer
 	#define SLIDER_WHEEL
 #endif
 
+#ifdef TOUCHPAD
+	#define SLIDER_WHEEL
+#endif
+
 #define RO_MASK         0xC0        // 1100 0000
 
+#if defined(SIMD_CUSTOM) && defined(EXTENDED_COUNTS)
+#error "SIMD_CUSTOM requires 16-bit counts, undefine EXTENDED_COUNTS"
+#endif
+#if defined(SIMD_CUSTOM) && defined(STUCK_TOUCH_RECOVERY)
+#error "STUCK_TOUCH_RECOVERY is not supported by SIMD_CUSTOM"
+#endif
+#if defined(SIMD_CUSTOM) && defined(ELEMENT_HYSTERESIS)
+#error "ELEMENT_HYSTERESIS is not supported by SIMD_CUSTOM"
+#endif
+
+/*
+ *  Measurement count width.  With EXTENDED_COUNTS the overflow interrupt of
+ *  the measurement timer provides the upper 16 bits of each count.
+ */
+#ifdef EXTENDED_COUNTS
+typedef uint32_t cts_count_t;
+#else
+typedef uint16_t cts_count_t;
+#endif
+
 /*
  *  The element structure identifies port input definitions for
  *  each element.
@@ -169,6 +304,15 @@ struct Element{
                                       
   uint16_t threshold;                   // specific threshold for each button
   uint16_t maxResponse;                 // Special Case: Slider max counts
+
+#ifdef ELEMENT_GATE
+  uint16_t accumulationCycles;          // gate override for this element,
+                                        // 0: use the sensor setting
+#endif
+#ifdef ELEMENT_HYSTERESIS
+  uint16_t releaseThreshold;            // end of touch, below threshold,
+                                        // 0: use threshold
+#endif
 };
 
 /*
@@ -187,12 +331,17 @@ struct Sensor{
  */
   uint16_t *inputCaptioctlRegister;
 
-  uint8_t numElements;             // number of elements within group
-  uint8_t baseOffset;              // the offset within the global 
+  uint16_t numElements;            // number of elements within group
+  uint16_t baseOffset;             // the offset within the global 
                                    // base_cnt array
 
+#ifdef FLEXIBLE_ELEMENT_ARRAY
+  struct Element const * const *arrayPtr;
+                                   // an array of numElements pointers
+#else
   struct Element const *arrayPtr[MAXIMUM_NUMBER_OF_ELEMENTS_PER_SENSOR];    
                                    // an array of pointers
+#endif
 
 //*****************************************************************************
 // Timer definitions
@@ -233,6 +382,10 @@ struct Sensor{
   uint8_t points;                   // Special Case: Number of points
                                     // along slider or wheel  
   uint8_t sensorThreshold;
+#ifdef SLIDER_LUT
+  uint8_t *positionLut;             // corrected position for each raw
+                                    // position 0 to points, 0: no correction
+#endif
 #endif                               
 
 };
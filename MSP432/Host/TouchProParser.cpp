@@ -0,0 +1,358 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   TouchProParser.cpp
+ *
+ *  @brief  Incremental parser for the frames sent by TouchProTool_Demo_UART
+ */
+#include "TouchProParser.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace touchpro {
+
+namespace {
+
+const uint8_t SYNC1[2] = { 0x55, 0xAA };   // DataHead
+const uint8_t SYNC2[2] = { 0xA5, 0x5A };   // DataHead2
+const uint8_t SYNC_TUNE[2] = { 0xA5, 0xC3 }; // TuneHead
+const size_t MAX_VARINT = 3;                // 17-bit zigzag delta
+const size_t MASK_OFFSET = 5;               // sync, control, sample number
+
+bool isSyncStart(uint8_t byte)
+{
+    return byte == SYNC1[0] || byte == SYNC2[0];
+}
+
+bool isSync(const uint8_t *data)
+{
+    return (data[0] == SYNC1[0] && data[1] == SYNC1[1])
+        || (data[0] == SYNC2[0] && data[1] == SYNC2[1])
+        || (data[0] == SYNC_TUNE[0] && data[1] == SYNC_TUNE[1]);
+}
+
+} // namespace
+
+struct Crc16Table {
+    uint16_t entry[256];
+
+    Crc16Table()
+    {
+        for (unsigned i = 0; i < 256; i++) {
+            uint16_t c = (uint16_t) (i << 8);
+            for (int bit = 0; bit < 8; bit++) {
+                c = (c & 0x8000) ? (uint16_t) ((c << 1) ^ 0x1021)
+                                 : (uint16_t) (c << 1);
+            }
+            entry[i] = c;
+        }
+    }
+};
+
+uint16_t crc16(const uint8_t *data, size_t size, uint16_t crc)
+{
+    static const Crc16Table table;
+
+    while (size--) {
+        crc = (uint16_t) ((crc << 8) ^ table.entry[(crc >> 8) ^ *data++]);
+    }
+    return crc;
+}
+
+void encodeCommand(uint8_t *command, uint8_t operation, uint8_t parameter,
+                   uint8_t index, uint16_t value)
+{
+    command[0] = SYNC_TUNE[0];
+    command[1] = SYNC_TUNE[1];
+    command[2] = operation;
+    command[3] = parameter;
+    command[4] = index;
+    command[5] = (uint8_t) (value >> 8);
+    command[6] = (uint8_t) value;
+    uint16_t crc = crc16(command + 2, 5);
+    command[7] = (uint8_t) (crc >> 8);
+    command[8] = (uint8_t) crc;
+}
+
+Parser::Parser(size_t channels)
+    : channels_(std::min(channels, MAX_CHANNELS))
+{
+    // format 1: sync, length byte, 3 bytes per channel, checksum
+    maxFrameSize_ = 3 + 255;
+    // format 2: sync, control, sample number, mask, varints, CRC
+    maxFrameSize_ = std::max(maxFrameSize_, MASK_OFFSET + (channels_ + 7) / 8
+                                            + channels_ * MAX_VARINT + 2);
+    pending_.reserve(2 * maxFrameSize_);
+    reset();
+    std::memset(&stats_, 0, sizeof(stats_));
+}
+
+void Parser::reset()
+{
+    pending_.clear();
+    std::memset(values_, 0, sizeof(values_));
+    synced_ = false;
+    nextSequence_ = 0;
+}
+
+void Parser::push(const uint8_t *data, size_t size, FrameHandler &handler)
+{
+    while (size) {
+        if (pending_.empty()) {
+            // decode in place, keep only an incomplete frame at the end
+            size_t used = scan(data, size, handler);
+            pending_.assign(data + used, data + size);
+            return;
+        }
+        // complete the pending frame with enough bytes for any frame
+        size_t old = pending_.size();
+        size_t take = std::min(size, 2 * maxFrameSize_ - old);
+        pending_.insert(pending_.end(), data, data + take);
+        size_t used = scan(pending_.data(), pending_.size(), handler);
+        if (used >= old) {
+            // continue in place behind the last frame
+            pending_.clear();
+            data += used - old;
+            size -= used - old;
+        } else {
+            pending_.erase(pending_.begin(), pending_.begin() + used);
+            data += take;
+            size -= take;
+        }
+    }
+}
+
+/*!
+ *  @return offset of the first byte not consumed: the start of an
+ *          incomplete frame or size
+ */
+size_t Parser::scan(const uint8_t *data, size_t size, FrameHandler &handler)
+{
+    size_t i = 0;
+    size_t frameSize;
+
+    while (i < size) {
+        if (!isSyncStart(data[i])) {
+            i++;
+            stats_.skippedBytes++;
+            continue;
+        }
+        if (i + 1 == size) {
+            return i;
+        }
+        if (!isSync(data + i)) {
+            i++;
+            stats_.skippedBytes++;
+            continue;
+        }
+        frame_.values = 0;
+        isResponse_ = false;
+        switch (decode(data + i, size - i, frameSize)) {
+        case COMPLETE:
+            if (isResponse_) {
+                handler.response(response_);
+            } else if (frame_.values) {
+                frame_.raw = data + i;
+                frame_.rawSize = frameSize;
+                stats_.frames++;
+                handler.frame(frame_);
+            }
+            i += frameSize;
+            break;
+        case INCOMPLETE:
+            return i;
+        case INVALID:
+            // false sync word or corrupted frame: search from the next byte
+            i++;
+            stats_.skippedBytes++;
+            break;
+        }
+    }
+    return size;
+}
+
+Parser::Result Parser::decode(const uint8_t *data, size_t size,
+                              size_t &frameSize)
+{
+    if (data[0] == SYNC1[0]) {
+        return decodeV1(data, size, frameSize);
+    }
+    if (data[1] == SYNC_TUNE[1]) {
+        frameSize = TUNE_FRAME_SIZE;
+        return decodeResponse(data, size);
+    }
+    return decodeV2(data, size, frameSize);
+}
+
+Parser::Result Parser::decodeResponse(const uint8_t *data, size_t size)
+{
+    if (size < TUNE_FRAME_SIZE) {
+        return INCOMPLETE;
+    }
+    if (!(data[2] & 0x80)) {
+        return INVALID;                 // a command, not a response
+    }
+    if (crc16(data + 2, 5) != ((data[7] << 8) | data[8])) {
+        stats_.checksumErrors++;
+        return INVALID;
+    }
+    response_.operation = data[2] & 0x3F;
+    response_.ok = (data[2] & 0xC0) == 0x80;
+    response_.parameter = data[3];
+    response_.index = data[4];
+    response_.value = (uint16_t) ((data[5] << 8) | data[6]);
+    isResponse_ = true;
+    return COMPLETE;
+}
+
+Parser::Result Parser::decodeV1(const uint8_t *data, size_t size,
+                                size_t &frameSize)
+{
+    if (size < 3) {
+        return INCOMPLETE;
+    }
+    size_t length = data[2];
+    if (length < 4 || (length - 1) % 3) {
+        return INVALID;
+    }
+    frameSize = 3 + length;
+    if (size < frameSize) {
+        return INCOMPLETE;
+    }
+    uint8_t sum = 0;
+    for (size_t i = 0; i < frameSize - 1; i++) {
+        sum = (uint8_t) (sum + data[i]);
+    }
+    if (sum != data[frameSize - 1]) {
+        stats_.checksumErrors++;
+        return INVALID;
+    }
+    size_t channels = (length - 1) / 3;
+    const uint8_t *p = data + 3;
+    for (size_t i = 0; i < channels; i++, p += 3) {
+        if (p[0] != i + 1) {
+            return INVALID;
+        }
+        decoded_[i] = (uint16_t) ((p[1] << 8) | p[2]);
+    }
+    frame_.format = 1;
+    frame_.sequence = 0;
+    frame_.key = true;
+    frame_.sample = 0;
+    frame_.channels = channels;
+    frame_.values = decoded_;
+    return COMPLETE;
+}
+
+Parser::Result Parser::decodeV2(const uint8_t *data, size_t size,
+                                size_t &frameSize)
+{
+    const size_t maskBytes = (channels_ + 7) / 8;
+
+    if (channels_ == 0) {
+        return INVALID;
+    }
+    if (size < MASK_OFFSET + maskBytes) {
+        return INCOMPLETE;
+    }
+    const uint8_t control = data[2];
+    const uint8_t *mask = data + MASK_OFFSET;
+    const bool key = (control & 0x80) != 0;
+    if (channels_ % 8 && (mask[maskBytes - 1] >> (channels_ % 8))) {
+        return INVALID;
+    }
+
+    // values are applied once the CRC has been checked
+    std::memcpy(decoded_, values_, channels_ * sizeof(decoded_[0]));
+    bool inRange = true;
+    size_t pos = MASK_OFFSET + maskBytes;
+    for (size_t i = 0; i < channels_; i++) {
+        if (!(mask[i / 8] & (1 << (i % 8)))) {
+            if (key) {
+                return INVALID;
+            }
+            continue;
+        }
+        uint32_t value = 0;
+        size_t n = 0;
+        do {
+            if (n == MAX_VARINT) {
+                return INVALID;
+            }
+            if (pos == size) {
+                return INCOMPLETE;
+            }
+            value |= (uint32_t) (data[pos] & 0x7F) << (7 * n++);
+        } while (data[pos++] & 0x80);
+        if (key) {
+            inRange = inRange && value <= 0xFFFF;
+            decoded_[i] = (uint16_t) value;
+        } else {
+            int32_t delta = (int32_t) (value >> 1) ^ -(int32_t) (value & 1);
+            int32_t next = decoded_[i] + delta;
+            inRange = inRange && next >= 0 && next <= 0xFFFF;
+            decoded_[i] = (uint16_t) next;
+        }
+    }
+    frameSize = pos + 2;
+    if (size < frameSize) {
+        return INCOMPLETE;
+    }
+    if (crc16(data + 2, pos - 2) != ((data[pos] << 8) | data[pos + 1])) {
+        stats_.checksumErrors++;
+        return INVALID;
+    }
+
+    const uint8_t sequence = control & 0x7F;
+    if (synced_ && sequence != nextSequence_) {
+        stats_.sequenceGaps += (sequence - nextSequence_) & 0x7F;
+        synced_ = false;
+    }
+    nextSequence_ = (sequence + 1) & 0x7F;
+    if (!inRange || !(key || synced_)) {
+        // the deltas refer to values not received: wait for a key frame
+        synced_ = false;
+        return COMPLETE;
+    }
+    synced_ = true;
+    std::memcpy(values_, decoded_, channels_ * sizeof(values_[0]));
+    frame_.format = 2;
+    frame_.sequence = sequence;
+    frame_.key = key;
+    frame_.sample = (uint16_t) ((data[3] << 8) | data[4]);
+    frame_.channels = channels_;
+    frame_.values = values_;
+    return COMPLETE;
+}
+
+} // namespace touchpro
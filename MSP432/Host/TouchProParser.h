@@ -0,0 +1,165 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   TouchProParser.h
+ *
+ *  @brief  Incremental parser for the frames sent by TouchProTool_Demo_UART
+ *
+ *  Two frame formats are recognized by their sync word:
+ *   - format 1 (DataHead 0x55AA), the Touch Pro GUI format: length byte,
+ *     (channel, high byte, low byte) per channel and an 8-bit sum of all
+ *     preceding bytes
+ *   - format 2 (DataHead2 0xA55A), the compact format: control byte, sample
+ *     number, channel mask, varint values or deltas and a CRC-16/CCITT, see
+ *     UART_sendTouchDataV2() in TouchProTool_Demo_UART.c
+ *  and the responses to tuning commands (TuneHead 0xA5C3), see
+ *  UART_tuneCommand().
+ *
+ *  Bytes are pushed in chunks of any size.  Frames lying entirely in a chunk
+ *  are decoded in place; only a frame split across chunks is copied into
+ *  the parser.  After a bad checksum the parser resynchronizes on the next
+ *  sync word.
+ */
+#ifndef TOUCHPRO_PARSER_H_
+#define TOUCHPRO_PARSER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace touchpro {
+
+//! Maximum number of channels of a frame
+const size_t MAX_CHANNELS = 84;
+
+//! A decoded frame, valid during the FrameHandler call only
+struct Frame {
+    uint8_t format;             //!< 1 or 2
+    uint8_t sequence;           //!< format 2: sequence number, 0-127
+    bool key;                   //!< format 2: frame holds all channels
+    uint16_t sample;            //!< format 2: sample number of the values
+    size_t channels;            //!< number of values
+    const uint16_t *values;     //!< channel values, channel 1 first
+    const uint8_t *raw;         //!< the frame as received, sync word first
+    size_t rawSize;
+};
+
+//! Tuning operations and parameters, see UART_tuneCommand()
+enum TuneOperation {
+    TUNE_READ = 0x01,
+    TUNE_WRITE = 0x02
+};
+
+enum TuneParameter {
+    TUNE_THRESHOLD = 0x01,
+    TUNE_MAX_RESPONSE = 0x02,
+    TUNE_RELEASE_THRESHOLD = 0x03,
+    TUNE_ACCUMULATION_CYCLES = 0x04,
+    TUNE_TRACKING_RATE = 0x05
+};
+
+//! Bytes of a tuning command or response
+const size_t TUNE_FRAME_SIZE = 9;
+
+//! A response to a tuning command
+struct Response {
+    uint8_t operation;          //!< TUNE_READ or TUNE_WRITE
+    bool ok;                    //!< false: unknown parameter or index
+    uint8_t parameter;
+    uint8_t index;
+    uint16_t value;             //!< value after the command
+};
+
+//! Receiver of the decoded frames
+class FrameHandler {
+public:
+    virtual ~FrameHandler() {}
+    virtual void frame(const Frame &frame) = 0;
+    virtual void response(const Response &) {}
+};
+
+//! Counters of the parser
+struct ParserStats {
+    uint64_t frames;            //!< frames passed to the handler
+    uint64_t checksumErrors;    //!< frames with a bad checksum or CRC
+    uint64_t skippedBytes;      //!< bytes discarded while searching for sync
+    uint64_t sequenceGaps;      //!< format 2 frames missed
+};
+
+class Parser {
+public:
+    /*!
+     *  @param channels number of channels of the format 2 frames (SENSOR_NUM
+     *         of the firmware), 0 to accept format 1 frames only
+     */
+    explicit Parser(size_t channels = 0);
+
+    //! Parse the next size bytes of the stream, calling handler per frame
+    void push(const uint8_t *data, size_t size, FrameHandler &handler);
+
+    //! Forget a partially received frame and the format 2 channel values
+    void reset();
+
+    const ParserStats &stats() const { return stats_; }
+
+private:
+    enum Result { COMPLETE, INCOMPLETE, INVALID };
+
+    size_t scan(const uint8_t *data, size_t size, FrameHandler &handler);
+    Result decode(const uint8_t *data, size_t size, size_t &frameSize);
+    Result decodeV1(const uint8_t *data, size_t size, size_t &frameSize);
+    Result decodeV2(const uint8_t *data, size_t size, size_t &frameSize);
+    Result decodeResponse(const uint8_t *data, size_t size);
+
+    size_t channels_;
+    size_t maxFrameSize_;
+    std::vector<uint8_t> pending_;  // frame split across push() calls
+    uint16_t values_[MAX_CHANNELS]; // values of the last frame
+    uint16_t decoded_[MAX_CHANNELS];
+    Frame frame_;
+    Response response_;
+    bool isResponse_;
+    bool synced_;                   // format 2 values_ are valid
+    uint8_t nextSequence_;
+    ParserStats stats_;
+};
+
+//! CRC-16/CCITT (polynomial 0x1021) of size bytes, seed crc
+uint16_t crc16(const uint8_t *data, size_t size, uint16_t crc = 0xFFFF);
+
+//! Write a tuning command to command[TUNE_FRAME_SIZE]
+void encodeCommand(uint8_t *command, uint8_t operation, uint8_t parameter,
+                   uint8_t index, uint16_t value);
+
+} // namespace touchpro
+
+#endif /* TOUCHPRO_PARSER_H_ */
@@ -0,0 +1,444 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   TouchProShm.cpp
+ *
+ *  @brief  Live frames of one board in POSIX shared memory
+ */
+#include "TouchProShm.h"
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#if ATOMIC_LLONG_LOCK_FREE != 2 || ATOMIC_INT_LOCK_FREE != 2
+#error "lock-free 32 and 64-bit atomics are needed in shared memory"
+#endif
+
+namespace touchpro {
+
+namespace {
+
+const uint32_t SHM_MAGIC = 0x54505348;  // "TPSH"
+const uint32_t SHM_VERSION = 2;
+const int POLL_INTERVAL = 100;          // us, without futex
+
+} // namespace
+
+struct ShmHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slots;
+    uint32_t slotSize;
+    std::atomic<uint64_t> head;         // frames published
+    std::atomic<uint32_t> signal;       // futex word, bumped per frame
+    std::atomic<uint32_t> waiters;      // readers in FUTEX_WAIT
+};
+
+struct ShmSlot {
+    std::atomic<uint64_t> version;      // 2 * index + 2 when complete
+    ShmFrame frame;
+};
+
+namespace {
+
+size_t mappingSize(uint32_t slots)
+{
+    return sizeof(ShmHeader) + (size_t) slots * sizeof(ShmSlot);
+}
+
+ShmSlot *slotsOf(const ShmHeader *header)
+{
+    return (ShmSlot *) (const_cast<ShmHeader *>(header) + 1);
+}
+
+void wake(ShmHeader *header)
+{
+#ifdef __linux__
+    // Pairs with the increment of waiters before a reader samples signal
+    if (header->waiters.load(std::memory_order_seq_cst) != 0) {
+        syscall(SYS_futex, &header->signal, FUTEX_WAKE, 0x7FFFFFFF, 0, 0, 0);
+    }
+#else
+    (void) header;
+#endif
+}
+
+bool validRing(const ShmHeader *header, uint32_t slots, size_t size)
+{
+    return header->magic == SHM_MAGIC && header->version == SHM_VERSION
+        && header->slots == slots && header->slotSize == sizeof(ShmSlot)
+        && mappingSize(slots) == size;
+}
+
+} // namespace
+
+uint16_t ShmFrame::channels() const
+{
+    uint16_t channels = channels_.load(std::memory_order_relaxed);
+    return channels < MAX_CHANNELS ? channels : (uint16_t) MAX_CHANNELS;
+}
+
+void ShmFrame::copy(ShmSample &sample) const
+{
+    sample.time = time();
+    sample.index = index();
+    sample.format = format();
+    sample.sequence = sequence();
+    sample.key = key();
+    sample.reserved = 0;
+    sample.sample = this->sample();
+    sample.channels = channels();
+    for (size_t i = 0; i < sample.channels; i++) {
+        sample.values[i] = value(i);
+    }
+}
+
+uint64_t hostTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t) ts.tv_sec * 1000000u + (uint64_t) ts.tv_nsec / 1000u;
+}
+
+ShmWriter::ShmWriter() : header_(0), slots_(0), size_(0)
+{
+}
+
+ShmWriter::~ShmWriter()
+{
+    close();
+}
+
+bool ShmWriter::open(const std::string &name, uint32_t slots)
+{
+    close();
+    if (slots == 0 || (slots & (slots - 1))) {
+        error_ = name + ": ring size must be a power of 2";
+        return false;
+    }
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        error_ = name + ": " + std::strerror(errno);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        error_ = name + ": " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    // Readers may have an existing ring mapped: resizing it would fault
+    // them (SIGBUS), so only an object that holds no ring is (re)sized
+    size_ = (size_t) st.st_size;
+    if (size_ >= sizeof(ShmHeader)) {
+        void *p = mmap(0, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            error_ = name + ": " + std::strerror(errno);
+            ::close(fd);
+            return false;
+        }
+        header_ = (ShmHeader *) p;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (validRing(header_, slots, size_)) {
+            ::close(fd);
+            slots_ = slotsOf(header_);
+            return true;                // continue the sequence
+        }
+        bool ring = header_->magic == SHM_MAGIC;
+        close();
+        if (ring) {
+            error_ = name + ": holds a ring of another size or version, "
+                     "remove it first";
+            ::close(fd);
+            return false;
+        }
+    }
+    size_ = mappingSize(slots);
+    if ((size_t) st.st_size != size_ && ftruncate(fd, (off_t) size_) != 0) {
+        error_ = name + ": " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+    void *p = mmap(0, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        error_ = name + ": " + std::strerror(errno);
+        return false;
+    }
+    header_ = (ShmHeader *) p;
+    slots_ = slotsOf(header_);
+
+    header_->magic = 0;
+    new (&header_->head) std::atomic<uint64_t>(0);
+    new (&header_->signal) std::atomic<uint32_t>(0);
+    new (&header_->waiters) std::atomic<uint32_t>(0);
+    for (uint32_t i = 0; i < slots; i++) {
+        new (&slots_[i]) ShmSlot();
+    }
+    header_->version = SHM_VERSION;
+    header_->slots = slots;
+    header_->slotSize = sizeof(ShmSlot);
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->magic = SHM_MAGIC;
+    return true;
+}
+
+void ShmWriter::close()
+{
+    if (header_) {
+        munmap(header_, size_);
+    }
+    header_ = 0;
+    slots_ = 0;
+}
+
+void ShmWriter::publish(const Frame &frame, uint64_t time)
+{
+    uint64_t index = header_->head.load(std::memory_order_relaxed);
+    ShmSlot &slot = slots_[index & (header_->slots - 1)];
+
+    ShmFrame &out = slot.frame;
+    const std::memory_order relaxed = std::memory_order_relaxed;
+
+    // Odd version: readers discard what they read of the slot meanwhile
+    slot.version.store(2 * index + 1, relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    out.time_.store(time, relaxed);
+    out.index_.store(index, relaxed);
+    out.format_.store(frame.format, relaxed);
+    out.sequence_.store(frame.sequence, relaxed);
+    out.key_.store(frame.key ? 1 : 0, relaxed);
+    out.reserved_.store(0, relaxed);
+    out.sample_.store(frame.sample, relaxed);
+    out.channels_.store((uint16_t) frame.channels, relaxed);
+    for (size_t i = 0; i < frame.channels; i++) {
+        out.values_[i].store(frame.values[i], relaxed);
+    }
+    slot.version.store(2 * index + 2, std::memory_order_release);
+    header_->head.store(index + 1, std::memory_order_release);
+
+    header_->signal.fetch_add(1, std::memory_order_seq_cst);
+    wake(header_);
+}
+
+ShmReader::ShmReader()
+    : header_(0), slots_(0), peeked_(0), control_(0), size_(0), next_(0),
+      lost_(0)
+{
+}
+
+ShmReader::~ShmReader()
+{
+    close();
+}
+
+bool ShmReader::open(const std::string &name, bool oldest)
+{
+    close();
+    // Write access to the header lets the reader announce that it waits
+    bool writable = true;
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0 && (errno == EACCES || errno == EPERM)) {
+        writable = false;
+        fd = shm_open(name.c_str(), O_RDONLY, 0);
+    }
+    if (fd < 0) {
+        error_ = name + ": " + std::strerror(errno);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(ShmHeader)) {
+        error_ = name + ": not a frame ring";
+        ::close(fd);
+        return false;
+    }
+    size_ = (size_t) st.st_size;
+    void *p = mmap(0, size_, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        error_ = name + ": " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+    header_ = (const ShmHeader *) p;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!validRing(header_, header_->slots, size_)) {
+        error_ = name + ": not a frame ring of this version";
+        ::close(fd);
+        close();
+        return false;
+    }
+    if (writable) {
+        p = mmap(0, sizeof(ShmHeader), PROT_READ | PROT_WRITE, MAP_SHARED,
+                 fd, 0);
+        control_ = p == MAP_FAILED ? 0 : (ShmHeader *) p;
+    }
+    ::close(fd);
+    slots_ = slotsOf(header_);
+    next_ = header_->head.load(std::memory_order_acquire);
+    if (oldest) {
+        next_ = next_ > header_->slots ? next_ - header_->slots : 0;
+    }
+    lost_ = 0;
+    peeked_ = 0;
+    return true;
+}
+
+void ShmReader::close()
+{
+    if (control_) {
+        munmap(control_, sizeof(ShmHeader));
+    }
+    if (header_) {
+        munmap(const_cast<ShmHeader *>(header_), size_);
+    }
+    header_ = 0;
+    slots_ = 0;
+    peeked_ = 0;
+    control_ = 0;
+}
+
+bool ShmReader::next(ShmSample &sample)
+{
+    for (;;) {
+        const ShmFrame *frame = peek();
+        if (!frame) {
+            return false;
+        }
+        frame->copy(sample);
+        if (release()) {
+            return true;
+        }
+    }
+}
+
+const ShmFrame *ShmReader::peek()
+{
+    if (peeked_) {
+        return &peeked_->frame;
+    }
+    for (;;) {
+        uint64_t head = header_->head.load(std::memory_order_acquire);
+        if (next_ >= head) {
+            if (next_ > head) {
+                next_ = head;           // ring recreated by a new writer
+            }
+            return 0;
+        }
+        if (head - next_ > header_->slots) {
+            lost_ += head - next_ - header_->slots;
+            next_ = head - header_->slots;
+        }
+
+        const ShmSlot &slot = slots_[next_ & (header_->slots - 1)];
+        if (slot.version.load(std::memory_order_acquire) == 2 * next_ + 2) {
+            peeked_ = &slot;
+            return &slot.frame;
+        }
+        // Overwritten by a newer frame before it could be read
+        lost_++;
+        next_++;
+    }
+}
+
+bool ShmReader::release()
+{
+    if (!peeked_) {
+        return false;
+    }
+    // Orders the relaxed loads of the frame before the version recheck
+    std::atomic_thread_fence(std::memory_order_acquire);
+    bool valid = peeked_->version.load(std::memory_order_relaxed)
+        == 2 * next_ + 2;
+    peeked_ = 0;
+    next_++;
+    if (!valid) {
+        lost_++;                        // overwritten while it was read
+    }
+    return valid;
+}
+
+bool ShmReader::wait(int timeout)
+{
+    uint64_t deadline = hostTime() + (uint64_t) timeout * 1000u;
+
+    for (;;) {
+#ifdef __linux__
+        if (control_) {
+            control_->waiters.fetch_add(1, std::memory_order_seq_cst);
+        }
+#endif
+        uint32_t signal = header_->signal.load(std::memory_order_seq_cst);
+        bool ready = header_->head.load(std::memory_order_acquire) != next_;
+        uint64_t now = hostTime();
+        if (!ready && now < deadline) {
+#ifdef __linux__
+            if (control_) {
+                struct timespec ts;
+                uint64_t left = deadline - now;
+                ts.tv_sec = (time_t) (left / 1000000u);
+                ts.tv_nsec = (long) (left % 1000000u) * 1000;
+                syscall(SYS_futex, &control_->signal, FUTEX_WAIT, signal,
+                        &ts, 0, 0);
+            } else {
+                usleep(POLL_INTERVAL);
+            }
+#else
+            (void) signal;
+            usleep(POLL_INTERVAL);
+#endif
+        }
+#ifdef __linux__
+        if (control_) {
+            control_->waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+#endif
+        if (ready) {
+            return true;
+        }
+        if (now >= deadline) {
+            return false;
+        }
+    }
+}
+
+} // namespace touchpro
@@ -0,0 +1,214 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   TouchProShm.h
+ *
+ *  @brief  Live frames of one board in POSIX shared memory
+ *
+ *  A ShmWriter (one process, one thread) publishes decoded frames into a
+ *  ring of fixed-size slots in a shared memory object (shm_open, mmap).
+ *  Any number of ShmReader processes map the object read-only and follow
+ *  the ring without locks: each slot carries a version that is odd while
+ *  the writer fills it, so a reader detects and skips a slot overwritten
+ *  while it was being read.  The fields of a slot are atomics accessed
+ *  with relaxed loads and stores, so a reader can read a frame in place
+ *  (peek, release) without racing the writer.  A reader that falls more
+ *  than a ring behind continues with the oldest slot still held and counts
+ *  the frames lost.  On Linux a waiting reader is woken with a futex as
+ *  soon as a frame is published, and the writer skips the wake-up while no
+ *  reader waits; a reader without write access to the object polls, as
+ *  do all readers elsewhere.
+ *
+ *  The object is named like a shm_open name, e.g. "/touchpro0", and stays
+ *  until it is removed (rm /dev/shm/touchpro0 on Linux); a writer that
+ *  reopens an object of the same geometry continues its sequence, so
+ *  attached readers keep working across a publisher restart.  A writer
+ *  refuses to reopen a ring of another geometry, which readers may still
+ *  have mapped.
+ */
+#ifndef TOUCHPRO_SHM_H_
+#define TOUCHPRO_SHM_H_
+
+#include "TouchProParser.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace touchpro {
+
+//! A frame as held in the ring
+struct ShmSample {
+    uint64_t time;              //!< host time of reception, us since epoch
+    uint64_t index;             //!< position in the ring sequence
+    uint8_t format;
+    uint8_t sequence;
+    uint8_t key;
+    uint8_t reserved;
+    uint16_t sample;
+    uint16_t channels;
+    uint16_t values[MAX_CHANNELS];
+};
+
+//! A frame read in place in the ring, see ShmReader::peek()
+class ShmFrame {
+public:
+    uint64_t time() const { return time_.load(std::memory_order_relaxed); }
+    uint64_t index() const { return index_.load(std::memory_order_relaxed); }
+    uint8_t format() const { return format_.load(std::memory_order_relaxed); }
+    uint8_t sequence() const
+    {
+        return sequence_.load(std::memory_order_relaxed);
+    }
+    uint8_t key() const { return key_.load(std::memory_order_relaxed); }
+    uint16_t sample() const { return sample_.load(std::memory_order_relaxed); }
+    //! Channels, at most MAX_CHANNELS even in a frame being overwritten
+    uint16_t channels() const;
+    uint16_t value(size_t i) const
+    {
+        return values_[i].load(std::memory_order_relaxed);
+    }
+
+    //! Copy the frame to sample
+    void copy(ShmSample &sample) const;
+
+private:
+    friend class ShmWriter;
+
+    std::atomic<uint64_t> time_;
+    std::atomic<uint64_t> index_;
+    std::atomic<uint8_t> format_;
+    std::atomic<uint8_t> sequence_;
+    std::atomic<uint8_t> key_;
+    std::atomic<uint8_t> reserved_;
+    std::atomic<uint16_t> sample_;
+    std::atomic<uint16_t> channels_;
+    std::atomic<uint16_t> values_[MAX_CHANNELS];
+};
+
+struct ShmHeader;
+struct ShmSlot;
+
+class ShmWriter {
+public:
+    ShmWriter();
+    ~ShmWriter();
+
+    /*!
+     *  @brief  Create or reopen the shared memory object name
+     *  @param  slots ring size in frames, a power of 2
+     *  @return false on error, see error(), also if name holds a ring of
+     *          another size or version
+     */
+    bool open(const std::string &name, uint32_t slots = 1024);
+    void close();
+
+    //! Publish a frame received at time (us since epoch)
+    void publish(const Frame &frame, uint64_t time);
+
+    const std::string &error() const { return error_; }
+
+private:
+    ShmWriter(const ShmWriter &);
+    ShmWriter &operator=(const ShmWriter &);
+
+    ShmHeader *header_;
+    ShmSlot *slots_;
+    size_t size_;
+    std::string error_;
+};
+
+class ShmReader {
+public:
+    ShmReader();
+    ~ShmReader();
+
+    /*!
+     *  @brief  Map the shared memory object name
+     *  @param  oldest start with the oldest frame held instead of the next
+     *          frame published
+     *  @return false on error, see error()
+     */
+    bool open(const std::string &name, bool oldest = false);
+    void close();
+
+    //! Copy the next frame to sample; false if there is no new frame
+    bool next(ShmSample &sample);
+
+    /*!
+     *  @brief  The next frame in place in the ring, without copying it
+     *
+     *  The frame stays in the ring and may be overwritten while it is
+     *  read; release() tells whether what was read of it is valid.
+     *  @return 0 if there is no new frame
+     */
+    const ShmFrame *peek();
+
+    /*!
+     *  @brief  Move past the frame returned by peek()
+     *  @return false if the frame was overwritten while it was read, and
+     *          what was read of it must be discarded
+     */
+    bool release();
+
+    /*!
+     *  @brief  Wait up to timeout milliseconds for a new frame
+     *  @return false on timeout
+     */
+    bool wait(int timeout);
+
+    //! Frames overwritten before they could be read
+    uint64_t lost() const { return lost_; }
+
+    const std::string &error() const { return error_; }
+
+private:
+    ShmReader(const ShmReader &);
+    ShmReader &operator=(const ShmReader &);
+
+    const ShmHeader *header_;
+    const ShmSlot *slots_;
+    const ShmSlot *peeked_;
+    ShmHeader *control_;                //!< header mapped writable, or 0
+    size_t size_;
+    uint64_t next_;
+    uint64_t lost_;
+    std::string error_;
+};
+
+//! Host time in microseconds since the epoch, as used by ShmSample::time
+uint64_t hostTime();
+
+} // namespace touchpro
+
+#endif /* TOUCHPRO_SHM_H_ */
@@ -0,0 +1,210 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   TouchProSource.cpp
+ *
+ *  @brief  Byte sources for the frame parser
+ */
+#include "TouchProSource.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace touchpro {
+
+namespace {
+
+bool baudConstant(unsigned long baud, speed_t &speed)
+{
+    static const struct {
+        unsigned long baud;
+        speed_t speed;
+    } rates[] = {
+        { 9600, B9600 }, { 19200, B19200 }, { 38400, B38400 },
+        { 57600, B57600 }, { 115200, B115200 }, { 230400, B230400 },
+#ifdef B460800
+        { 460800, B460800 },
+#endif
+#ifdef B921600
+        { 921600, B921600 },
+#endif
+#ifdef B1000000
+        { 1000000, B1000000 },
+#endif
+    };
+
+    for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        if (rates[i].baud == baud) {
+            speed = rates[i].speed;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+Source::Source()
+    : fd_(-1), owned_(false), tty_(false), interruptible_(false)
+{
+}
+
+Source::~Source()
+{
+    close();
+}
+
+bool Source::open(const std::string &path, unsigned long baud,
+                  bool writable)
+{
+    close();
+    if (path == "-") {
+        fd_ = STDIN_FILENO;
+        return true;
+    }
+    fd_ = ::open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_NOCTTY);
+    if (fd_ < 0) {
+        error_ = path + ": " + std::strerror(errno);
+        return false;
+    }
+    owned_ = true;
+    tty_ = isatty(fd_);
+    if (!tty_) {
+        return true;
+    }
+
+    struct termios tio;
+    speed_t speed;
+    if (!baudConstant(baud, speed)) {
+        error_ = path + ": unsupported baud rate";
+        close();
+        return false;
+    }
+    if (tcgetattr(fd_, &tio) != 0) {
+        error_ = path + ": " + std::strerror(errno);
+        close();
+        return false;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | PARENB);
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    if (tcsetattr(fd_, TCSANOW, &tio) != 0) {
+        error_ = path + ": " + std::strerror(errno);
+        close();
+        return false;
+    }
+    tcflush(fd_, TCIFLUSH);
+    return true;
+}
+
+void Source::close()
+{
+    if (owned_) {
+        ::close(fd_);
+    }
+    fd_ = -1;
+    owned_ = false;
+    tty_ = false;
+}
+
+bool Source::setNonBlocking()
+{
+    int flags = fcntl(fd_, F_GETFL);
+
+    if (flags < 0 || fcntl(fd_, F_SETFL, flags | O_NONBLOCK) < 0) {
+        error_ = std::strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+long Source::read(uint8_t *buffer, size_t size)
+{
+    ssize_t n;
+
+    do {
+        n = ::read(fd_, buffer, size);
+    } while (n < 0 && errno == EINTR && !interruptible_);
+    if (n < 0 && errno == EINTR) {
+        return INTERRUPTED;
+    }
+    if (n < 0 && errno == EIO && tty_) {
+        return 0;                       // other side of a pseudo-terminal closed
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return WOULD_BLOCK;
+    }
+    if (n < 0) {
+        error_ = std::strerror(errno);
+    }
+    return (long) n;
+}
+
+bool Source::wait(int timeout)
+{
+    struct pollfd fds;
+    int n;
+
+    fds.fd = fd_;
+    fds.events = POLLIN;
+    do {
+        n = poll(&fds, 1, timeout);
+    } while (n < 0 && errno == EINTR);
+    return n > 0;
+}
+
+bool Source::write(const uint8_t *data, size_t size)
+{
+    while (size) {
+        ssize_t n = ::write(fd_, data, size);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            error_ = std::strerror(errno);
+            return false;
+        }
+        data += n;
+        size -= (size_t) n;
+    }
+    return true;
+}
+
+} // namespace touchpro
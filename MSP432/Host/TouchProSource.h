@@ -0,0 +1,109 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   TouchProSource.h
+ *
+ *  @brief  Byte sources for the frame parser: a serial device set to raw
+ *          mode, a file or standard input
+ */
+#ifndef TOUCHPRO_SOURCE_H_
+#define TOUCHPRO_SOURCE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace touchpro {
+
+class Source {
+public:
+    Source();
+    ~Source();
+
+    /*!
+     *  @brief  Open path, "-" for standard input.  A terminal device is set
+     *          to raw 8N1 at baud.
+     *  @param  writable also open for writing, see write()
+     *  @return false on error, see error()
+     */
+    bool open(const std::string &path, unsigned long baud,
+              bool writable = false);
+    void close();
+
+    //! Return WOULD_BLOCK from read() instead of waiting for bytes
+    bool setNonBlocking();
+
+    /*!
+     *  @brief  Return INTERRUPTED from read() when a signal interrupts the
+     *          wait for bytes instead of waiting again, so that the caller
+     *          can check a flag set by its handler
+     */
+    void setInterruptible(bool interruptible = true)
+    {
+        interruptible_ = interruptible;
+    }
+
+    /*!
+     *  @return bytes read, 0 at end of file, -1 on error, WOULD_BLOCK if a
+     *          non-blocking source has no bytes yet, INTERRUPTED if an
+     *          interruptible source was interrupted by a signal
+     */
+    long read(uint8_t *buffer, size_t size);
+    static const long WOULD_BLOCK = -2;
+    static const long INTERRUPTED = -3;
+
+    /*!
+     *  @brief  Wait up to timeout milliseconds for bytes to read
+     *  @return false on timeout
+     */
+    bool wait(int timeout);
+
+    //! @return false unless all size bytes were written
+    bool write(const uint8_t *data, size_t size);
+
+    int fd() const { return fd_; }
+    const std::string &error() const { return error_; }
+
+private:
+    Source(const Source &);
+    Source &operator=(const Source &);
+
+    int fd_;
+    bool owned_;
+    bool tty_;
+    bool interruptible_;
+    std::string error_;
+};
+
+} // namespace touchpro
+
+#endif /* TOUCHPRO_SOURCE_H_ */
@@ -0,0 +1,377 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   TouchProTrace.cpp
+ *
+ *  @brief  Append-only binary trace of the counts of a tuning session
+ */
+#include "TouchProTrace.h"
+#include "TouchProShm.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace touchpro {
+
+namespace {
+
+const char TRACE_MAGIC[8] = "TPTRACE";
+const uint16_t TRACE_VERSION = 1;
+const uint32_t INDEX_MAGIC = 0x58444954;    // "TIDX"
+const size_t WRITE_BUFFER = 1 << 20;
+
+size_t align8(size_t size)
+{
+    return (size + 7) & ~(size_t) 7;
+}
+
+} // namespace
+
+unsigned traceFieldCount(uint16_t fields)
+{
+    return ((fields & TRACE_RAW) ? 1 : 0) + ((fields & TRACE_BASELINE) ? 1 : 0)
+        + ((fields & TRACE_DELTA) ? 1 : 0);
+}
+
+bool readTraceChannels(const std::string &path,
+                       std::vector<TraceChannel> &channels,
+                       std::string &error)
+{
+    std::ifstream file(path.c_str());
+    std::string line;
+    unsigned number = 0;
+
+    if (!file) {
+        error = path + ": " + std::strerror(errno);
+        return false;
+    }
+    channels.clear();
+    while (std::getline(file, line)) {
+        number++;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string sensor, element;
+        unsigned long threshold, maxResponse;
+        if (!(fields >> sensor >> element >> threshold >> maxResponse)) {
+            std::ostringstream message;
+            message << path << ":" << number
+                    << ": expected sensor element threshold maxResponse";
+            error = message.str();
+            return false;
+        }
+        TraceChannel channel;
+        std::memset(&channel, 0, sizeof(channel));
+        std::strncpy(channel.sensor, sensor.c_str(),
+                     sizeof(channel.sensor) - 1);
+        std::strncpy(channel.element, element.c_str(),
+                     sizeof(channel.element) - 1);
+        channel.threshold = (uint32_t) threshold;
+        channel.maxResponse = (uint32_t) maxResponse;
+        channels.push_back(channel);
+    }
+    return true;
+}
+
+TraceWriter::TraceWriter() : file_(0), records_(0)
+{
+}
+
+TraceWriter::~TraceWriter()
+{
+    close();
+}
+
+bool TraceWriter::open(const std::string &path, uint16_t fields,
+                       const std::vector<TraceChannel> &channels,
+                       uint32_t indexInterval)
+{
+    close();
+    fields &= TRACE_RAW | TRACE_BASELINE | TRACE_DELTA;
+    if (!fields || channels.empty() || indexInterval == 0) {
+        error_ = path + ": no fields, channels or index interval";
+        return false;
+    }
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        error_ = path + ": " + std::strerror(errno);
+        return false;
+    }
+    std::setvbuf(file_, 0, _IOFBF, WRITE_BUFFER);
+
+    std::memset(&header_, 0, sizeof(header_));
+    std::memcpy(header_.magic, TRACE_MAGIC, sizeof(header_.magic));
+    header_.byteOrder = TRACE_BYTE_ORDER;
+    header_.version = TRACE_VERSION;
+    header_.fields = fields;
+    header_.channels = (uint32_t) channels.size();
+    header_.recordSize = (uint32_t) align8(sizeof(TraceRecord)
+        + traceFieldCount(fields) * channels.size() * sizeof(uint32_t));
+    header_.indexInterval = indexInterval;
+    header_.dataOffset = (uint32_t) align8(sizeof(TraceHeader)
+        + channels.size() * sizeof(TraceChannel));
+    header_.startTime = hostTime();
+
+    static const uint8_t zeros[8] = { 0 };
+    if (!write(&header_, sizeof(header_))
+            || !write(&channels[0], channels.size() * sizeof(TraceChannel))
+            || !write(zeros, header_.dataOffset - sizeof(TraceHeader)
+                      - channels.size() * sizeof(TraceChannel))) {
+        close();
+        return false;
+    }
+    records_ = 0;
+    return true;
+}
+
+bool TraceWriter::close()
+{
+    bool ok = true;
+
+    if (file_) {
+        ok = std::fclose(file_) == 0;
+        if (!ok) {
+            error_ = std::strerror(errno);
+        }
+    }
+    file_ = 0;
+    return ok;
+}
+
+bool TraceWriter::write(const void *data, size_t size)
+{
+    if (size && std::fwrite(data, 1, size, file_) != size) {
+        error_ = std::strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+bool TraceWriter::append(uint64_t time, uint32_t scan, uint32_t flags,
+                         const uint32_t *values)
+{
+    static const uint8_t zeros[8] = { 0 };
+    size_t valueSize = traceFieldCount(header_.fields) * header_.channels
+        * sizeof(uint32_t);
+    TraceRecord record;
+    uint32_t position = (uint32_t) (records_ % header_.indexInterval);
+
+    record.time = time;
+    record.scan = scan;
+    record.flags = flags;
+    if (position == 0) {
+        index_.magic = INDEX_MAGIC;
+        index_.block = (uint32_t) (records_ / header_.indexInterval);
+        index_.firstTime = time;
+        index_.firstScan = scan;
+        index_.reserved = 0;
+    }
+    index_.lastTime = time;
+    if (!write(&record, sizeof(record)) || !write(values, valueSize)
+            || !write(zeros, header_.recordSize - sizeof(record) - valueSize)) {
+        return false;
+    }
+    records_++;
+    if (position == header_.indexInterval - 1) {
+        return write(&index_, sizeof(index_));
+    }
+    return true;
+}
+
+TraceReader::TraceReader()
+    : data_(0), size_(0), header_(0), channels_(0), records_(0),
+      indexed_(0)
+{
+}
+
+TraceReader::~TraceReader()
+{
+    close();
+}
+
+bool TraceReader::open(const std::string &path)
+{
+    close();
+    path_ = path;
+    if (!map()) {
+        return false;
+    }
+    if (size_ < sizeof(TraceHeader)
+            || std::memcmp(header_->magic, TRACE_MAGIC,
+                           sizeof(header_->magic)) != 0) {
+        error_ = path + ": not a trace";
+    } else if (header_->byteOrder != TRACE_BYTE_ORDER) {
+        error_ = path + ": written with another byte order";
+    } else if (header_->version != TRACE_VERSION) {
+        error_ = path + ": unsupported trace version";
+    } else if (header_->indexInterval == 0 || header_->channels == 0
+            || header_->recordSize < sizeof(TraceRecord)
+                + traceFieldCount(header_->fields) * header_->channels
+                * sizeof(uint32_t)
+            || header_->dataOffset < sizeof(TraceHeader)
+                + header_->channels * sizeof(TraceChannel)
+            || header_->dataOffset > size_) {
+        error_ = path + ": damaged trace header";
+    } else {
+        count();
+        return true;
+    }
+    close();
+    return false;
+}
+
+void TraceReader::close()
+{
+    if (data_) {
+        munmap(const_cast<uint8_t *>(data_), size_);
+    }
+    data_ = 0;
+    size_ = 0;
+    header_ = 0;
+    channels_ = 0;
+    records_ = 0;
+    indexed_ = 0;
+}
+
+bool TraceReader::map()
+{
+    int fd = ::open(path_.c_str(), O_RDONLY);
+    struct stat st;
+
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        error_ = path_ + ": " + std::strerror(errno);
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+    if (st.st_size == 0) {
+        ::close(fd);
+        error_ = path_ + ": empty file";
+        return false;
+    }
+    void *p = mmap(0, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        error_ = path_ + ": " + std::strerror(errno);
+        return false;
+    }
+    if (data_) {
+        munmap(const_cast<uint8_t *>(data_), size_);
+    }
+    data_ = (const uint8_t *) p;
+    size_ = (size_t) st.st_size;
+    header_ = (const TraceHeader *) data_;
+    channels_ = (const TraceChannel *) (header_ + 1);
+    return true;
+}
+
+bool TraceReader::refresh()
+{
+    if (!map()) {
+        return false;
+    }
+    count();
+    return true;
+}
+
+void TraceReader::count()
+{
+    uint64_t interval = header_->indexInterval;
+    uint64_t block = interval * header_->recordSize + sizeof(TraceIndex);
+    uint64_t data = size_ - header_->dataOffset;
+    uint64_t tail = (data % block) / header_->recordSize;
+
+    // The last block may be complete while its index is not (yet)
+    indexed_ = data / block;
+    records_ = indexed_ * interval + (tail < interval ? tail : interval);
+}
+
+const uint32_t *TraceReader::values(uint64_t i, TraceField field) const
+{
+    if (!(header_->fields & field)) {
+        return 0;
+    }
+    // Fields present before this one
+    unsigned before = traceFieldCount(header_->fields & (field - 1));
+    return (const uint32_t *) (&record(i) + 1) + before * header_->channels;
+}
+
+uint64_t TraceReader::find(uint64_t time) const
+{
+    uint64_t interval = header_->indexInterval;
+    uint64_t block = header_->recordSize * interval;
+    uint64_t low = 0, high = indexed_;
+
+    // First indexed block whose last record is at or after time
+    while (low < high) {
+        uint64_t middle = low + (high - low) / 2;
+        const TraceIndex *index = (const TraceIndex *) (data_
+            + header_->dataOffset + middle * (block + sizeof(TraceIndex))
+            + block);
+        if (index->lastTime < time) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    // Then the first record at or after time in that block, or one by one
+    // in the records after the last index entry
+    low *= interval;
+    if (low == indexed_ * interval) {
+        while (low < records_ && record(low).time < time) {
+            low++;
+        }
+        return low;
+    }
+    high = low + interval;
+    while (low < high) {
+        uint64_t middle = low + (high - low) / 2;
+        if (record(middle).time < time) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+} // namespace touchpro
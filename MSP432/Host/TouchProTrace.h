@@ -0,0 +1,225 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   TouchProTrace.h
+ *
+ *  @brief  Append-only binary trace of the counts of a tuning session
+ *
+ *  A trace file holds, per scan, the raw counts, baselines and/or delta
+ *  counts of each element, in the byte order of the host that wrote it:
+ *
+ *   - TraceHeader, followed by one TraceChannel per element giving the
+ *     sensor, element name, threshold and maxResponse from structure.c
+ *   - records in blocks of indexInterval: each record is recordSize bytes,
+ *     a TraceRecord followed by the values (uint32_t) of the fields present,
+ *     first all channels of the first field, then of the next
+ *   - after every complete block a TraceIndex with the time range and the
+ *     first scan of the block
+ *
+ *  Record i therefore lies at a computable offset, and a time is found by a
+ *  binary search over the index entries followed by one within a block;
+ *  the records after the last complete index entry are searched one by
+ *  one.  A trace cut short (e.g. by a crash of the writer) or still being
+ *  written stays readable up to its last complete record.
+ *
+ *  TraceReader maps the file and returns pointers into the mapping, so
+ *  records are neither parsed nor copied.
+ */
+#ifndef TOUCHPRO_TRACE_H_
+#define TOUCHPRO_TRACE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace touchpro {
+
+//! Fields of a trace, TraceHeader::fields is a combination of them
+enum TraceField {
+    TRACE_RAW = 0x01,           //!< raw counts, TI_CAPT_Raw()
+    TRACE_BASELINE = 0x02,      //!< baseline counts
+    TRACE_DELTA = 0x04          //!< delta counts, TI_CAPT_Custom()
+};
+
+const uint32_t TRACE_BYTE_ORDER = 0x01020304;
+
+struct TraceHeader {
+    char magic[8];              //!< "TPTRACE" and a 0 byte
+    uint32_t byteOrder;         //!< TRACE_BYTE_ORDER as written
+    uint16_t version;
+    uint16_t fields;            //!< TraceField combination
+    uint32_t channels;          //!< elements per record
+    uint32_t recordSize;        //!< bytes per record
+    uint32_t indexInterval;     //!< records per block
+    uint32_t dataOffset;        //!< offset of the first record
+    uint64_t startTime;         //!< us since epoch
+};
+
+struct TraceChannel {
+    char sensor[24];            //!< sensor name, 0 terminated
+    char element[24];           //!< element name, 0 terminated
+    uint32_t threshold;
+    uint32_t maxResponse;
+};
+
+struct TraceRecord {
+    uint64_t time;              //!< host time, us since epoch
+    uint32_t scan;              //!< scan number, e.g. the sample number
+    uint32_t flags;             //!< TRACE_KEY if the frame held all channels
+    // uint32_t values[fields][channels] follow
+};
+
+const uint32_t TRACE_KEY = 0x01;
+
+struct TraceIndex {
+    uint32_t magic;             //!< "TIDX"
+    uint32_t block;
+    uint64_t firstTime;
+    uint64_t lastTime;
+    uint32_t firstScan;
+    uint32_t reserved;
+};
+
+//! Number of fields in a TraceField combination
+unsigned traceFieldCount(uint16_t fields);
+
+/*!
+ *  @brief  Read the channels from a text file with one line per element,
+ *          "sensor element threshold maxResponse", as written by
+ *          touchpro_meta.py from a structure.c
+ *  @return false on error, with the reason in error
+ */
+bool readTraceChannels(const std::string &path,
+                       std::vector<TraceChannel> &channels,
+                       std::string &error);
+
+class TraceWriter {
+public:
+    TraceWriter();
+    ~TraceWriter();
+
+    /*!
+     *  @brief  Create the trace path
+     *  @param  fields TraceField combination recorded
+     *  @param  channels one entry per element
+     *  @return false on error, see error()
+     */
+    bool open(const std::string &path, uint16_t fields,
+              const std::vector<TraceChannel> &channels,
+              uint32_t indexInterval = 1024);
+
+    //! Write the buffered records and close the file
+    bool close();
+
+    /*!
+     *  @brief  Append a record; values holds channels values per field, in
+     *          the order of TraceField
+     */
+    bool append(uint64_t time, uint32_t scan, uint32_t flags,
+                const uint32_t *values);
+
+    const std::string &error() const { return error_; }
+
+private:
+    TraceWriter(const TraceWriter &);
+    TraceWriter &operator=(const TraceWriter &);
+
+    bool write(const void *data, size_t size);
+
+    std::FILE *file_;
+    TraceHeader header_;
+    TraceIndex index_;
+    uint64_t records_;
+    std::string error_;
+};
+
+class TraceReader {
+public:
+    TraceReader();
+    ~TraceReader();
+
+    //! Map the trace path; false on error, see error()
+    bool open(const std::string &path);
+    void close();
+
+    /*!
+     *  @brief  Map the records appended since open() or the last refresh()
+     *  @return false on error
+     */
+    bool refresh();
+
+    const TraceHeader &header() const { return *header_; }
+    const TraceChannel &channel(size_t i) const { return channels_[i]; }
+    size_t channels() const { return header_->channels; }
+    uint64_t records() const { return records_; }
+
+    //! Record i, i < records()
+    const TraceRecord &record(uint64_t i) const
+    {
+        uint64_t interval = header_->indexInterval;
+        return *(const TraceRecord *) (data_ + header_->dataOffset
+            + i * header_->recordSize + (i / interval) * sizeof(TraceIndex));
+    }
+
+    /*!
+     *  @brief  Values of a field of record i, channels() of them
+     *  @return 0 if the field is not recorded
+     */
+    const uint32_t *values(uint64_t i, TraceField field) const;
+
+    //! First record at or after time, records() if there is none
+    uint64_t find(uint64_t time) const;
+
+    const std::string &error() const { return error_; }
+
+private:
+    TraceReader(const TraceReader &);
+    TraceReader &operator=(const TraceReader &);
+
+    bool map();
+    void count();
+
+    std::string path_;
+    const uint8_t *data_;
+    size_t size_;
+    const TraceHeader *header_;
+    const TraceChannel *channels_;
+    uint64_t records_;
+    uint64_t indexed_;                  //!< blocks with a complete index
+    std::string error_;
+};
+
+} // namespace touchpro
+
+#endif /* TOUCHPRO_TRACE_H_ */
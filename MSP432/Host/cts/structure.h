@@ -0,0 +1,289 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+//******************************************************************************
+// structure.h
+//
+//! \brief Configuration for building the Capacitive Touch layer on the host
+//!        (see Host/Makefile).  The HAL is replaced by CTS_HostHAL.c, which
+//!        returns the counts stored in hostCounts[].  Options under test, for
+//!        example SIMD_CUSTOM, are defined on the compiler command line.
+//******************************************************************************
+#ifndef CTS_STRUCTURE_H_
+#define CTS_STRUCTURE_H_
+
+#include "msp.h"
+#include <stdint.h>
+
+//****** RAM ALLOCATION ********************************************************
+#define TOTAL_NUMBER_OF_ELEMENTS 1024
+#define RAM_FOR_FLASH
+
+//****** Structure Array Definition ********************************************
+#define MAXIMUM_NUMBER_OF_ELEMENTS_PER_SENSOR  1024
+
+//****** Measurement Methods ***************************************************
+// One RO and one fRO method so that both directions of interest are covered
+#define RO_CTIO_TA2_WDTA            73
+#define fRO_CTIO_TA2_TA3            23
+
+//****** Layer Options *********************************************************
+#define SLIDER
+#define ILLEGAL_SLIDER_WHEEL_POSITION		0xFFFF
+#define WHEEL
+#define MATRIX
+#define ILLEGAL_MATRIX_KEY                  0xFFFF
+#define ROI_RADIUS                          1
+#define ROI_FULL_SCAN_INTERVAL              8
+#define CALLBACK_SENSORS                    4
+#define STUCK_TOUCH_SCANS                   1000
+#define RECOVERY_SCANS                      4
+#define TRACKING_ALPHA                      128
+#define TRACKING_BETA                       32
+#define TRACKING_LEAD                       1
+#define FLEXIBLE_ELEMENT_ARRAY
+
+//******************************************************************************
+// End of user configuration section.
+//******************************************************************************
+//******************************************************************************
+//******************************************************************************
+
+//possible timer source clock dividers, different from clock module dividers
+#define TIMER_TxCLK 	   TASSEL__TACLK
+#define TIMER_ACLK  	   TASSEL__ACLK
+#define TIMER_SMCLK 	   TASSEL__SMCLK
+#define TIMER_INCLK 	   TASSEL__INCLK
+
+#define TIMER_SOURCE_DIV_0     ID_0		// Timer A Source/1
+#define TIMER_SOURCE_DIV_1     ID_1     // Timer A Source/2
+#define TIMER_SOURCE_DIV_2     ID_2     // Timer A Source/4
+#define TIMER_SOURCE_DIV_3     ID_3     // Timer A Source/8
+
+#define GATE_WDTA_SMCLK    WDTSSEL__SMCLK
+#define GATE_WDTA_ACLK     WDTSSEL__ACLK
+#define GATE_WDTA_VLO      WDTSSEL__VLOCLK
+#define GATE_WDTA_BCLK     WDTSSEL__BCLK
+
+#define WDTA_GATE_2G       WDTIS_0  // watchdog source/2G
+#define WDTA_GATE_128M     WDTIS_1  // watchdog source/128M
+#define WDTA_GATE_8192K    WDTIS_2  // watchdog source/8192K
+#define WDTA_GATE_512K     WDTIS_3  // watchdog source/512K
+#define WDTA_GATE_32768    WDTIS_4  // watchdog source/32768
+#define WDTA_GATE_8192     WDTIS_5  // watchdog source/8192
+#define WDTA_GATE_512      WDTIS_6  // watchdog source/512
+#define WDTA_GATE_64       WDTIS_7  // watchdog source/64
+
+
+// The below variables are used to excluded portions of code not needed by
+// the method chosen by the user. Uncomment the type used prior to compilation.
+// Multiple types can be chosen as needed.
+// What Method(s) are used in this application?
+
+#ifdef RO_CTIO_TA2_WDTA
+    #define RO_TYPE
+    #define WDT_GATE
+    #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #define TIMERA2_NOVERFLOW
+    #endif
+#endif
+
+#ifdef RO_CTIO_TA2_TA3
+    #define RO_TYPE
+    #define TIMER_SCALE
+    #define TIMERA3_0GATE
+    #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #define TIMERA2_NOVERFLOW
+    #endif
+#endif
+
+#ifdef fRO_CTIO_TA2_TA3
+    #define RO_TYPE
+    #define TIMER_SCALE
+    #define TIMERA2_0GATE
+    #define HAL_DEFINITION
+    #ifdef EXTENDED_COUNTS
+        #define TIMERA3_NOVERFLOW
+    #endif
+#endif
+
+
+#ifdef SLIDER
+	#define SLIDER_WHEEL
+#endif
+
+#ifdef WHEEL
+	#define SLIDER_WHEEL
+#endif
+
+#ifdef TOUCHPAD
+	#define SLIDER_WHEEL
+#endif
+
+#define RO_MASK         0xC0        // 1100 0000
+
+#if defined(SIMD_CUSTOM) && defined(EXTENDED_COUNTS)
+#error "SIMD_CUSTOM requires 16-bit counts, undefine EXTENDED_COUNTS"
+#endif
+#if defined(SIMD_CUSTOM) && defined(STUCK_TOUCH_RECOVERY)
+#error "STUCK_TOUCH_RECOVERY is not supported by SIMD_CUSTOM"
+#endif
+#if defined(SIMD_CUSTOM) && defined(ELEMENT_HYSTERESIS)
+#error "ELEMENT_HYSTERESIS is not supported by SIMD_CUSTOM"
+#endif
+
+/*
+ *  Measurement count width.  With EXTENDED_COUNTS the overflow interrupt of
+ *  the measurement timer provides the upper 16 bits of each count.
+ */
+#ifdef EXTENDED_COUNTS
+typedef uint32_t cts_count_t;
+#else
+typedef uint16_t cts_count_t;
+#endif
+
+/*
+ *  The element structure identifies port input definitions for
+ *  each element.
+ */
+struct Element{
+ 		     
+  uint16_t inputBits;                 // FastRO+RO: bit
+                                      // definition
+                                      
+  uint16_t threshold;                   // specific threshold for each button
+  uint16_t maxResponse;                 // Special Case: Slider max counts
+
+#ifdef ELEMENT_GATE
+  uint16_t accumulationCycles;          // gate override for this element,
+                                        // 0: use the sensor setting
+#endif
+#ifdef ELEMENT_HYSTERESIS
+  uint16_t releaseThreshold;            // end of touch, below threshold,
+                                        // 0: use threshold
+#endif
+};
+
+/*
+ *  The sensor structure identifies HAL and timing definitions for
+ *  each sensor.
+ */
+
+struct Sensor{
+  // the method acts as the switch to determine which HAL is called
+  uint8_t halDefinition;           // RO
+                                   // FAST_SCAN_RO
+
+/*
+ *  This register address definition is needed to indicate which CTIOxCTL
+ *  register is associated with the Timer identified in the HAL.
+ */
+  uint16_t *inputCaptioctlRegister;
+
+  uint16_t numElements;            // number of elements within group
+  uint16_t baseOffset;             // the offset within the global 
+                                   // base_cnt array
+
+#ifdef FLEXIBLE_ELEMENT_ARRAY
+  struct Element const * const *arrayPtr;
+                                   // an array of numElements pointers
+#else
+  struct Element const *arrayPtr[MAXIMUM_NUMBER_OF_ELEMENTS_PER_SENSOR];    
+                                   // an array of pointers
+#endif
+
+//*****************************************************************************
+// Timer definitions
+//  The basic premise is to count a number of clock cycles within a time
+//  period, where either the clock source or the timer period is a function
+//  of the element capacitance.
+//
+// RO Method:
+//          Period: accumulationCycles*measGateSource/sourceScale 
+//                  (with WDT sourceScale = 1, accumulationCycles is WDT control
+//                   register settings)
+//
+//          clock source: relaxation oscillator where freq is a function of C
+//
+// fRO Method:
+//          Period: accumulationCycles * 1/freq, freq is a function of C
+//
+//          clock source: measGateSource/sourceScale
+     
+  uint16_t measGateSource;         // FastRO: measurement timer source,
+                                   // {ACLK, TACLK, SMCLK}
+  	  	  	  	  	  	  	  	   // RO: gate timer source,
+                                   // {ACLK, TACLK, SMCLK}
+#ifdef TIMER_SCALE
+  uint16_t sourceScale;            // RO: gate timer,
+                                   // TA, scale: 1,1/2,1/4,1/8
+                                   // FastRO: measurement timer, TA
+  	  	  	  	  	  	  	  	   // scale:
+                                   // Not used for WDTA
+#endif
+    
+  uint16_t accumulationCycles;
+  
+//*****************************************************************************
+// Other definitions
+
+#ifdef SLIDER_WHEEL  
+  uint8_t points;                   // Special Case: Number of points
+                                    // along slider or wheel  
+  uint8_t sensorThreshold;
+#ifdef SLIDER_LUT
+  uint8_t *positionLut;             // corrected position for each raw
+                                    // position 0 to points, 0: no correction
+#endif
+#endif                               
+
+};
+
+/*
+ *  The GCC language extension within CCS is needed, otherwise a warning will
+ *  be generated during compilation when no problems exist or an error will be
+ *  generated (instead of a warning) when a problem does exist.
+ */
+#ifndef TOTAL_NUMBER_OF_ELEMENTS
+ #warning "WARNING: TOTAL_NUMBER_OF_ELEMENTS is not defined in structure.h. Only TI_CAPT_RAW function is enabled."
+#endif
+
+#ifndef RAM_FOR_FLASH
+ #warning "WARNING: The HEAP must be set appropriately.  Please refer to SLAA490 for details."
+#endif
+
+#ifndef HAL_DEFINITION
+ #warning "WARNING: At least one HAL definition must be made in structure.h."
+#endif
+
+#endif /* CTS_STRUCTURE_H_ */
@@ -0,0 +1,141 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   cts_bench.c
+ *
+ *  @brief  Scan processing cost of the Capacitive Touch layer on the host
+ *          for sensors of 8 to 1024 elements: TI_CAPT_Custom(),
+ *          TI_CAPT_Buttons() and TI_CAPT_Update_Baseline() per scan and per
+ *          element.  The measurement is the copy of CTS_HostHAL.c, so the
+ *          time is that of the layer.  A per-element cost that stays flat
+ *          as the group grows shows linear scaling.
+ *
+ *          cts_bench [element scans per size]
+ */
+#include "CTS_Layer.h"
+#include "CTS_HostHAL.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static struct Element elements[MAXIMUM_NUMBER_OF_ELEMENTS_PER_SENSOR];
+static const struct Element *elementPtrs[MAXIMUM_NUMBER_OF_ELEMENTS_PER_SENSOR];
+static cts_count_t deltaCnt[MAXIMUM_NUMBER_OF_ELEMENTS_PER_SENSOR];
+
+static double Now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ *  Counts of the next scan: untouched elements wander around 3000, one in
+ *  32 elements is touched
+ */
+static void Next_Counts(uint16_t numElements, unsigned scan)
+{
+    uint16_t i;
+
+    for(i = 0; i < numElements; i++)
+    {
+        hostCounts[i] = 3000 + rand() % 7 - 3;
+        if(((i + scan) & 31) == 0)
+        {
+            hostCounts[i] -= 200;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long work = argc > 1 ? strtoul(argv[1], 0, 10) : 4000000;
+    struct Sensor sensor = {0};
+    uint16_t numElements;
+    unsigned scan, scans;
+    double start, custom, buttons, baseline;
+    uint16_t i;
+
+    if(work == 0)
+    {
+        fprintf(stderr, "usage: cts_bench [element scans per size]\n");
+        return 2;
+    }
+    for(i = 0; i < MAXIMUM_NUMBER_OF_ELEMENTS_PER_SENSOR; i++)
+    {
+        elements[i].threshold = 100;
+        elements[i].maxResponse = 600;
+        elementPtrs[i] = &elements[i];
+    }
+    sensor.halDefinition = RO_CTIO_TA2_WDTA;
+    sensor.arrayPtr = elementPtrs;
+    printf("elements  Custom ns/scan  ns/element  Buttons ns/element"
+           "  Update_Baseline ns/element\n");
+    for(numElements = 8; numElements <= MAXIMUM_NUMBER_OF_ELEMENTS_PER_SENSOR;
+        numElements *= 2)
+    {
+        sensor.numElements = numElements;
+        scans = work / numElements;
+        srand(1);
+        Next_Counts(numElements, 0);
+        TI_CAPT_Init_Baseline(&sensor);
+
+        custom = 0;
+        buttons = 0;
+        for(scan = 0; scan < scans; scan++)
+        {
+            // new counts outside the timed calls
+            Next_Counts(numElements, scan);
+            start = Now();
+            TI_CAPT_Custom(&sensor, deltaCnt);
+            custom += Now() - start;
+            Next_Counts(numElements, scan);
+            start = Now();
+            TI_CAPT_Buttons(&sensor);
+            buttons += Now() - start;
+        }
+        start = Now();
+        for(scan = 0; scan < scans / 8; scan++)
+        {
+            TI_CAPT_Update_Baseline(&sensor, 8);
+        }
+        baseline = Now() - start;
+
+        printf("%8u  %14.0f  %10.2f  %18.2f  %26.2f\n", numElements,
+               custom / scans * 1e9, custom / scans / numElements * 1e9,
+               buttons / scans / numElements * 1e9,
+               baseline / (scans / 8) / 8 / numElements * 1e9);
+    }
+    return 0;
+}
@@ -0,0 +1,209 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   test_callbacks.c
+ *
+ *  @brief  Checks the SENSOR_CALLBACKS dispatch of TI_CAPT_Buttons() and
+ *          TI_CAPT_Slider(): press, release and the per-element callbacks
+ *          of buttons, also when the touch moves from one button to
+ *          another, and press, position change and release of a slider,
+ *          with nothing called while the state stays the same.
+ *
+ *          Built with SENSOR_CALLBACKS and linked with the layer built the
+ *          same way, its symbols prefixed with cb_, see Makefile.
+ */
+#include "CTS_Layer.h"
+#include "CTS_HostHAL.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define BASE 3000
+
+const struct Element *cb_TI_CAPT_Buttons(const struct Sensor *);
+uint16_t cb_TI_CAPT_Slider(const struct Sensor *);
+uint8_t cb_TI_CAPT_Register_Callbacks(const struct Sensor *,
+                                      struct SensorCallbacks *);
+extern cts_count_t cb_baseCnt[];
+
+// percent = delta - 100 between threshold and maxResponse
+static const struct Element element = { .threshold = 100, .maxResponse = 200 };
+static const struct Element *elementPtrs[] = {
+    &element, &element, &element, &element };
+static const struct Sensor buttons = {
+    .halDefinition = RO_CTIO_TA2_WDTA, .numElements = 3, .baseOffset = 0,
+    .arrayPtr = elementPtrs };
+static const struct Sensor slider = {
+    .halDefinition = RO_CTIO_TA2_WDTA, .numElements = 4, .baseOffset = 3,
+    .arrayPtr = elementPtrs, .points = 64, .sensorThreshold = 50 };
+
+static char events[256];
+static int failures;
+
+static void Event(const char *name, const struct Sensor *sensor,
+                  uint16_t value)
+{
+    size_t length = strlen(events);
+
+    snprintf(events + length, sizeof(events) - length, "%s %s %u, ",
+             sensor == &buttons ? "buttons" : "slider", name, value);
+}
+
+static void Press(const struct Sensor *sensor, uint16_t value)
+{
+    Event("press", sensor, value);
+}
+
+static void Release(const struct Sensor *sensor, uint16_t value)
+{
+    Event("release", sensor, value);
+}
+
+static void Position_Change(const struct Sensor *sensor, uint16_t value)
+{
+    Event("position", sensor, value);
+}
+
+static void Press_A(void) { Event("press A", &buttons, 0); }
+static void Release_A(void) { Event("release A", &buttons, 0); }
+static void Press_B(void) { Event("press B", &buttons, 1); }
+
+// no element callbacks for button C, and none on the release of button B
+static void (* const elementPress[])(void) = { Press_A, Press_B, 0 };
+static void (* const elementRelease[])(void) = { Release_A, 0, 0 };
+
+static struct SensorCallbacks buttonCallbacks = {
+    .press = Press, .release = Release,
+    .elementPress = elementPress, .elementRelease = elementRelease };
+static struct SensorCallbacks sliderCallbacks = {
+    .press = Press, .release = Release, .positionChange = Position_Change };
+
+//! Measure sensor with the given deltas (RO: the counts fall below the
+//! baseline)
+static void Set_Deltas(const struct Sensor *sensor, const uint16_t *deltas)
+{
+    uint16_t i;
+
+    for(i = 0; i < sensor->numElements; i++)
+    {
+        cb_baseCnt[sensor->baseOffset + i] = BASE + deltas[i];
+        hostCounts[i] = BASE;
+    }
+}
+
+static void Check(const char *what, const char *expected)
+{
+    if(strcmp(events, expected))
+    {
+        printf("test_callbacks: %s: \"%s\", expected \"%s\"\n", what,
+               events, expected);
+        failures++;
+    }
+    events[0] = 0;
+}
+
+static void Scan_Buttons(const uint16_t *deltas)
+{
+    Set_Deltas(&buttons, deltas);
+    cb_TI_CAPT_Buttons(&buttons);
+}
+
+static void Scan_Slider(const uint16_t *deltas)
+{
+    Set_Deltas(&slider, deltas);
+    cb_TI_CAPT_Slider(&slider);
+}
+
+int main(void)
+{
+    static const uint16_t none[] = { 0, 0, 0, 0 };
+    static const uint16_t buttonA[] = { 200, 0, 0 };
+    static const uint16_t buttonB[] = { 0, 200, 0 };
+    static const uint16_t buttonC[] = { 0, 0, 200 };
+    // element 1 at 100 percent: position 16 + 8
+    static const uint16_t slider24[] = { 0, 200, 0, 0 };
+    // element 2 at 50 percent besides: position 24 + 8
+    static const uint16_t slider32[] = { 0, 200, 150, 0 };
+
+    if(!cb_TI_CAPT_Register_Callbacks(&buttons, &buttonCallbacks)
+       || !cb_TI_CAPT_Register_Callbacks(&slider, &sliderCallbacks))
+    {
+        printf("test_callbacks: registration failed\n");
+        return 1;
+    }
+
+    Scan_Buttons(none);
+    Check("buttons untouched", "");
+    Scan_Buttons(buttonA);
+    Check("button A pressed", "buttons press 0, buttons press A 0, ");
+    Scan_Buttons(buttonA);
+    Check("button A held", "");
+    Scan_Buttons(buttonB);
+    Check("button A to B", "buttons release 0, buttons release A 0, "
+          "buttons press 1, buttons press B 1, ");
+    Scan_Buttons(buttonC);
+    Check("button B to C", "buttons release 1, buttons press 2, ");
+    Scan_Buttons(none);
+    Check("button C released", "buttons release 2, ");
+    Scan_Buttons(none);
+    Check("buttons still untouched", "");
+
+    Scan_Slider(slider24);
+    Check("slider pressed", "slider press 24, ");
+    Scan_Slider(slider24);
+    Check("slider held", "");
+    Scan_Slider(slider32);
+    Check("slider moved", "slider position 32, ");
+    Scan_Slider(none);
+    Check("slider released", "slider release 32, ");
+    Scan_Slider(none);
+    Check("slider still untouched", "");
+
+    // a sensor registered again starts untouched, one removed is silent
+    Scan_Buttons(buttonA);
+    Check("button A pressed again", "buttons press 0, buttons press A 0, ");
+    cb_TI_CAPT_Register_Callbacks(&buttons, &buttonCallbacks);
+    Scan_Buttons(buttonA);
+    Check("button A after registering again",
+          "buttons press 0, buttons press A 0, ");
+    cb_TI_CAPT_Register_Callbacks(&buttons, 0);
+    Scan_Buttons(none);
+    Check("buttons removed", "");
+
+    if(failures)
+    {
+        return 1;
+    }
+    printf("test_callbacks: press, release and position change of buttons "
+           "and slider as expected\n");
+    return 0;
+}
@@ -0,0 +1,207 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   test_custom.c
+ *
+ *  @brief  Checks that the packed two-element path of TI_CAPT_Custom()
+ *          (SIMD_CUSTOM) gives the same deltas, baselines and status flags
+ *          as the element by element code, for random scans and for the
+ *          edge cases of the counts: 0 (no measurement), the threshold,
+ *          maxResponse and the 16-bit limits.
+ *
+ *          The packed build of CTS_Layer.c is linked with its symbols
+ *          prefixed with packed_, see Makefile.
+ */
+#include "CTS_Layer.h"
+#include "CTS_HostHAL.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define ELEMENTS 64
+
+extern cts_count_t baseCnt[];
+extern uint16_t ctsStatusReg;
+
+void packed_TI_CAPT_Custom(const struct Sensor *, cts_count_t *);
+extern cts_count_t packed_baseCnt[];
+extern uint16_t packed_ctsStatusReg;
+
+static struct Element elements[ELEMENTS];
+static const struct Element *elementPtrs[ELEMENTS];
+static uint32_t seed = 1;
+
+static uint32_t Random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+/*
+ *  A count near the baseline, threshold or maxResponse of the element, or
+ *  at one of the limits
+ */
+static cts_count_t Edge_Count(cts_count_t base, const struct Element *e)
+{
+    int32_t offsets[] = {0, 1, -1, e->threshold, -(int32_t)e->threshold,
+                         e->threshold - 1, 1 - (int32_t)e->threshold,
+                         e->threshold / 2, -(int32_t)(e->threshold / 2),
+                         e->maxResponse, -(int32_t)e->maxResponse};
+    int32_t count;
+
+    switch(Random() % 8)
+    {
+    case 0:
+        return 0;
+    case 1:
+        return 0xFFFF;
+    case 2:
+        return 1;
+    case 3:
+        return Random() & 0xFFFF;
+    default:
+        count = base + offsets[Random() % (sizeof(offsets)/sizeof(offsets[0]))];
+        if(count < 0)
+        {
+            count = 0;
+        }
+        return count > 0xFFFF ? 0xFFFF : (cts_count_t)count;
+    }
+}
+
+static uint16_t Edge_Threshold(void)
+{
+    switch(Random() % 6)
+    {
+    case 0:
+        return 0;
+    case 1:
+        return 1;
+    case 2:
+        return 0xFFFF;
+    case 3:
+        return 0x8000 + (Random() & 0x7FFF);
+    default:
+        return Random() % 1024;
+    }
+}
+
+static cts_count_t Edge_Base(void)
+{
+    switch(Random() % 6)
+    {
+    case 0:
+        return 0;
+    case 1:
+        return 0xFFFF;
+    case 2:
+        return Random() & 0xFFFF;
+    default:
+        return 30000 + Random() % 400;
+    }
+}
+
+int main(void)
+{
+    static const uint16_t rates[] = {
+        TRADOI_FAST, TRADOI_MED, TRADOI_SLOW, TRADOI_VSLOW };
+    static const uint16_t tracking[] = {
+        TRIDOI_VSLOW, TRIDOI_SLOW, TRIDOI_MED, TRIDOI_FAST };
+    cts_count_t scalar[ELEMENTS], packed[ELEMENTS];
+    struct Sensor sensor;
+    unsigned long scan, scans = 500000;
+    uint16_t i;
+
+    for(i = 0; i < ELEMENTS; i++)
+    {
+        elementPtrs[i] = &elements[i];
+    }
+    for(scan = 0; scan < scans; scan++)
+    {
+        memset(&sensor, 0, sizeof(sensor));
+        sensor.numElements = 1 + Random() % (ELEMENTS / 2);
+        sensor.baseOffset = Random() % (ELEMENTS - sensor.numElements + 1);
+        sensor.halDefinition = (Random() & 1) ? RO_CTIO_TA2_WDTA
+                                              : fRO_CTIO_TA2_TA3;
+        sensor.arrayPtr = elementPtrs;
+        for(i = 0; i < ELEMENTS; i++)
+        {
+            elements[i].threshold = Edge_Threshold();
+            elements[i].maxResponse = elements[i].threshold
+                                      + Random() % 2000;
+            if((scan % 64) == 0 || (Random() % 4) == 0)
+            {
+                baseCnt[i] = Edge_Base();
+            }
+            packed_baseCnt[i] = baseCnt[i];
+        }
+        for(i = 0; i < sensor.numElements; i++)
+        {
+            hostCounts[i] = Edge_Count(baseCnt[sensor.baseOffset + i],
+                                       &elements[i]);
+        }
+        ctsStatusReg = (Random() & (DOI_MASK | PAST_EVNT | EVNT))
+                       | rates[scan % 4] | tracking[(scan / 4) % 4];
+        packed_ctsStatusReg = ctsStatusReg;
+
+        TI_CAPT_Custom(&sensor, scalar);
+        packed_TI_CAPT_Custom(&sensor, packed);
+
+        for(i = 0; i < sensor.numElements; i++)
+        {
+            if(scalar[i] != packed[i])
+            {
+                printf("test_custom: scan %lu element %u: delta %u, packed %u\n",
+                       scan, i, scalar[i], packed[i]);
+                return 1;
+            }
+        }
+        for(i = 0; i < ELEMENTS; i++)
+        {
+            if(baseCnt[i] != packed_baseCnt[i])
+            {
+                printf("test_custom: scan %lu baseline %u: %u, packed %u\n",
+                       scan, i, baseCnt[i], packed_baseCnt[i]);
+                return 1;
+            }
+        }
+        if(ctsStatusReg != packed_ctsStatusReg)
+        {
+            printf("test_custom: scan %lu status 0x%02x, packed 0x%02x\n",
+                   scan, ctsStatusReg, packed_ctsStatusReg);
+            return 1;
+        }
+    }
+    printf("test_custom: %lu scans, packed and scalar results identical\n",
+           scans);
+    return 0;
+}
@@ -0,0 +1,168 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   test_hysteresis.c
+ *
+ *  @brief  Checks the ELEMENT_HYSTERESIS handling of Dominant_Element() and
+ *          TI_CAPT_Matrix(): an element held between its release threshold
+ *          and threshold stays dominant with 0 percent, percentages are
+ *          relative to threshold on touch and while held, and held lines
+ *          count as active when detecting ghost keys.
+ *
+ *          Built with ELEMENT_HYSTERESIS and linked with the layer built
+ *          the same way, its symbols prefixed with hyst_, see Makefile.
+ */
+#include "CTS_Layer.h"
+#include "CTS_HostHAL.h"
+
+#include <stdio.h>
+
+#define BASE 3000
+
+void hyst_TI_CAPT_Custom(const struct Sensor *, cts_count_t *);
+uint16_t hyst_Dominant_Element(const struct Sensor *, cts_count_t *);
+uint16_t hyst_TI_CAPT_Matrix(const struct Sensor *, const struct Sensor *);
+extern cts_count_t hyst_baseCnt[];
+
+static const struct Element lines[4] = {
+    { .threshold = 100, .maxResponse = 600, .releaseThreshold = 60 },
+    { .threshold = 100, .maxResponse = 600, .releaseThreshold = 60 },
+    { .threshold = 100, .maxResponse = 600, .releaseThreshold = 60 },
+    { .threshold = 200, .maxResponse = 200+655, .releaseThreshold = 10 }};
+static const struct Element *rowPtrs[] = { &lines[0], &lines[1] };
+static const struct Element *columnPtrs[] = { &lines[2], &lines[3] };
+static const struct Sensor rows = {
+    .halDefinition = RO_CTIO_TA2_WDTA, .numElements = 2, .baseOffset = 0,
+    .arrayPtr = rowPtrs };
+static const struct Sensor columns = {
+    .halDefinition = RO_CTIO_TA2_WDTA, .numElements = 2, .baseOffset = 2,
+    .arrayPtr = columnPtrs };
+
+static int failures;
+
+static void Check(const char *what, unsigned value, unsigned expected)
+{
+    if(value != expected)
+    {
+        printf("test_hysteresis: %s: %u, expected %u\n", what, value,
+               expected);
+        failures++;
+    }
+}
+
+/*
+ *  Measure the elements of sensor with the given deltas (RO: the counts
+ *  fall below the baseline)
+ */
+static void Set_Deltas(const struct Sensor *sensor, uint16_t d0, uint16_t d1)
+{
+    hyst_baseCnt[sensor->baseOffset] = BASE + d0;
+    hyst_baseCnt[sensor->baseOffset + 1] = BASE + d1;
+    hostCounts[0] = BASE;
+    hostCounts[1] = BASE;
+}
+
+static uint16_t Percent(uint16_t delta, const struct Element *e)
+{
+    if(delta > e->maxResponse)
+    {
+        delta = e->maxResponse;
+    }
+    return delta > e->threshold
+           ? 100 * (delta - e->threshold) / (e->maxResponse - e->threshold)
+           : 0;
+}
+
+int main(void)
+{
+    cts_count_t deltaCnt[2];
+    uint16_t index;
+
+    // touch: percentages relative to threshold, not to the release threshold
+    Set_Deltas(&rows, 300, 0);
+    hyst_TI_CAPT_Custom(&rows, deltaCnt);
+    index = hyst_Dominant_Element(&rows, deltaCnt);
+    Check("touch index", index, 0);
+    Check("touch percent", deltaCnt[0], Percent(300, &lines[0]));
+
+    // held between release threshold and threshold: dominant, 0 percent
+    Set_Deltas(&rows, 80, 0);
+    hyst_TI_CAPT_Custom(&rows, deltaCnt);
+    index = hyst_Dominant_Element(&rows, deltaCnt);
+    Check("held index", index, 0);
+    Check("held percent", deltaCnt[0], 0);
+
+    // just above threshold while held: continuous with the touch
+    Set_Deltas(&rows, 101, 0);
+    hyst_TI_CAPT_Custom(&rows, deltaCnt);
+    hyst_Dominant_Element(&rows, deltaCnt);
+    Check("held above threshold percent", deltaCnt[0], Percent(101, &lines[0]));
+
+    // below the release threshold: released
+    Set_Deltas(&rows, 50, 0);
+    hyst_TI_CAPT_Custom(&rows, deltaCnt);
+    hyst_Dominant_Element(&rows, deltaCnt);
+    Check("released percent", deltaCnt[0], 0);
+
+    // a low release threshold does not widen the normalization range, so
+    // 100*(maxResponse - threshold) stays within 16 bits
+    Set_Deltas(&columns, 0, 2000);
+    hyst_TI_CAPT_Custom(&columns, deltaCnt);
+    hyst_Dominant_Element(&columns, deltaCnt);
+    Check("full response percent", deltaCnt[1], 100);
+    Set_Deltas(&columns, 0, 150);
+    hyst_TI_CAPT_Custom(&columns, deltaCnt);
+    hyst_Dominant_Element(&columns, deltaCnt);
+    Check("held low percent", deltaCnt[1], 0);
+    Set_Deltas(&columns, 0, 0);
+    hyst_TI_CAPT_Custom(&columns, deltaCnt);
+
+    // matrix: row 0 and column 1 pressed
+    Set_Deltas(&rows, 300, 0);
+    Set_Deltas(&columns, 0, 300);
+    Check("matrix key", hyst_TI_CAPT_Matrix(&rows, &columns), 1);
+
+    // row 0 and column 1 held, row 1 and column 0 pressed: the held lines
+    // are still active, so the keys are ambiguous
+    Set_Deltas(&rows, 80, 300);
+    Set_Deltas(&columns, 300, 80);
+    Check("matrix ghost", hyst_TI_CAPT_Matrix(&rows, &columns),
+          ILLEGAL_MATRIX_KEY);
+
+    if(failures)
+    {
+        return 1;
+    }
+    printf("test_hysteresis: touch, hold and release of Dominant_Element "
+           "and TI_CAPT_Matrix as expected\n");
+    return 0;
+}
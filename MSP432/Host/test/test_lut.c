@@ -0,0 +1,162 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   test_lut.c
+ *
+ *  @brief  Checks the SLIDER_LUT calibration: TI_CAPT_Calibrate_Position_Lut()
+ *          interpolates between the knots of a slider, and
+ *          TI_CAPT_Calibrate_Wheel_Lut() takes the knots of a wheel modulo
+ *          points, so a sweep that wraps through raw position 0 maps every
+ *          raw position, raw position points included, to 0..points-1, also
+ *          through TI_CAPT_Wheel().
+ *
+ *          Built with SLIDER_LUT and linked with the layer built the same
+ *          way, its symbols prefixed with lut_, see Makefile.
+ */
+#include "CTS_Layer.h"
+#include "CTS_HostHAL.h"
+
+#include <stdio.h>
+
+#define BASE 3000
+#define POINTS 64
+
+void lut_TI_CAPT_Calibrate_Position_Lut(const struct Sensor *,
+                                        const uint16_t *, uint8_t);
+void lut_TI_CAPT_Calibrate_Wheel_Lut(const struct Sensor *, const uint16_t *,
+                                     uint8_t);
+uint16_t lut_TI_CAPT_Wheel(const struct Sensor *);
+extern cts_count_t lut_baseCnt[];
+
+// percent = delta - 100 between threshold and maxResponse
+static const struct Element element = { .threshold = 100, .maxResponse = 200 };
+static const struct Element *elementPtrs[] = {
+    &element, &element, &element, &element };
+static uint8_t sliderLut[POINTS + 1];
+static uint8_t wheelLut[POINTS + 1];
+static const struct Sensor slider = {
+    .halDefinition = RO_CTIO_TA2_WDTA, .numElements = 4, .baseOffset = 0,
+    .arrayPtr = elementPtrs, .points = POINTS, .sensorThreshold = 50,
+    .positionLut = sliderLut };
+static const struct Sensor wheel = {
+    .halDefinition = RO_CTIO_TA2_WDTA, .numElements = 4, .baseOffset = 0,
+    .arrayPtr = elementPtrs, .points = POINTS, .sensorThreshold = 50,
+    .positionLut = wheelLut };
+
+static int failures;
+
+static void Check(const char *what, unsigned value, unsigned expected)
+{
+    if(value != expected)
+    {
+        printf("test_lut: %s: %u, expected %u\n", what, value, expected);
+        failures++;
+    }
+}
+
+//! Measure the wheel with the given deltas (RO: the counts fall below the
+//! baseline)
+static void Set_Deltas(const uint16_t *deltas)
+{
+    uint16_t i;
+
+    for(i = 0; i < wheel.numElements; i++)
+    {
+        lut_baseCnt[wheel.baseOffset + i] = BASE + deltas[i];
+        hostCounts[i] = BASE;
+    }
+}
+
+int main(void)
+{
+    // slider knots at 0, 21, 42 and 64, the last read short of the end
+    static const uint16_t sliderKnots[] = { 0, 10, 40, 60 };
+    // wheel knots at 0, 16, 32 and 48, knot 0 read before raw position 0
+    static const uint16_t wheelKnots[] = { 60, 12, 30, 44 };
+    // element 0 at 100 percent and element 3 at 57 percent: raw position
+    // 8 - 57*16/100 = -1, which TI_CAPT_Wheel wraps to points
+    static const uint16_t wrapDeltas[] = { 200, 0, 0, 157 };
+    unsigned raw;
+    unsigned wrapped = 0;
+
+    lut_TI_CAPT_Calibrate_Position_Lut(&slider, sliderKnots, 4);
+    Check("slider knot 0", sliderLut[0], 0);
+    Check("slider between knots", sliderLut[5], 10);
+    Check("slider knot 1", sliderLut[10], 21);
+    Check("slider knot 2", sliderLut[40], 42);
+    Check("slider last knot", sliderLut[60], 64);
+    Check("slider end", sliderLut[64], 64);
+
+    lut_TI_CAPT_Calibrate_Wheel_Lut(&wheel, wheelKnots, 0);
+    for(raw = 0; raw < POINTS; raw++)
+    {
+        Check("wheel identity", wheelLut[raw], raw);
+    }
+    Check("wheel identity points", wheelLut[POINTS], 0);
+
+    lut_TI_CAPT_Calibrate_Wheel_Lut(&wheel, wheelKnots, 4);
+    Check("wheel knot 0", wheelLut[60], 0);
+    Check("wheel knot 1", wheelLut[12], 16);
+    Check("wheel knot 2", wheelLut[30], 32);
+    Check("wheel knot 3", wheelLut[44], 48);
+    // past knot 0 before the raw wrap: 2 of 16 raw to knot 1
+    Check("wheel after knot 0", wheelLut[62], 2);
+    // past the raw wrap: 4 of 16 raw to knot 1
+    Check("wheel after raw wrap", wheelLut[0], 4);
+    // last segment, raw 44 to 60 back at knot 0
+    Check("wheel last segment", wheelLut[50], 54);
+    Check("wheel points", wheelLut[POINTS], wheelLut[0]);
+    for(raw = 0; raw <= POINTS; raw++)
+    {
+        if(wheelLut[raw] >= POINTS)
+        {
+            Check("wheel range", wheelLut[raw], POINTS - 1);
+        }
+        // going round the corrected position wraps to 0 once, at knot 0
+        if((raw > 0) && (wheelLut[raw] < wheelLut[raw-1]))
+        {
+            wrapped++;
+        }
+    }
+    Check("wheel wraps", wrapped, 1);
+
+    Set_Deltas(wrapDeltas);
+    Check("wheel position at points", lut_TI_CAPT_Wheel(&wheel),
+          wheelLut[POINTS]);
+
+    if(failures)
+    {
+        return 1;
+    }
+    printf("test_lut: slider and wheel position tables as expected\n");
+    return 0;
+}
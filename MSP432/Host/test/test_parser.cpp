@@ -0,0 +1,525 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   test_parser.cpp
+ *
+ *  @brief  Loopback test of Source and Parser over a pseudo-terminal.
+ *
+ *          Format 1 frames, format 2 frames and tuning responses are
+ *          written to the master side as TouchProTool_Demo_UART sends them
+ *          and read back from the slave through Source.  Every stream is
+ *          delivered split at each offset and byte by byte.  The decoded
+ *          values and the ParserStats counters are checked for clean
+ *          streams, corrupted checksum and CRC bytes, and lost frames.
+ */
+#include "TouchProParser.h"
+#include "TouchProSource.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+const size_t CHANNELS = 10;     // two mask bytes in format 2
+
+int failures;
+
+void check(bool ok, const std::string &test, const char *what)
+{
+    if (!ok) {
+        std::printf("test_parser: %s: %s\n", test.c_str(), what);
+        failures++;
+    }
+}
+
+//! A frame or response as the handler saw it
+struct Event {
+    int kind;                   // frame format 1 or 2, 0 for a response
+    uint8_t sequence;
+    bool key;
+    uint16_t sample;
+    std::vector<uint16_t> values;
+    touchpro::Response response;
+
+    bool operator==(const Event &other) const
+    {
+        if (kind != other.kind) {
+            return false;
+        }
+        if (kind == 0) {
+            return response.operation == other.response.operation
+                && response.ok == other.response.ok
+                && response.parameter == other.response.parameter
+                && response.index == other.response.index
+                && response.value == other.response.value;
+        }
+        return sequence == other.sequence && key == other.key
+            && sample == other.sample && values == other.values;
+    }
+};
+
+class Recorder : public touchpro::FrameHandler {
+public:
+    void frame(const touchpro::Frame &frame)
+    {
+        Event event = Event();
+        event.kind = frame.format;
+        event.sequence = frame.sequence;
+        event.key = frame.key;
+        event.sample = frame.sample;
+        event.values.assign(frame.values, frame.values + frame.channels);
+        events.push_back(event);
+    }
+
+    void response(const touchpro::Response &response)
+    {
+        Event event = Event();
+        event.response = response;
+        events.push_back(event);
+    }
+
+    std::vector<Event> events;
+};
+
+/*!
+ *  A byte stream and the events the parser must report for it.  The
+ *  frames are encoded as UART_sendTouchData(), UART_sendTouchDataV2() and
+ *  UART_tuneCommand() send them.
+ */
+class Stream {
+public:
+    Stream() : sequence_(0), sample_(0), sent_(CHANNELS, 0) {}
+
+    //! Append a format 1 frame, return its offset
+    size_t v1(const std::vector<uint16_t> &values)
+    {
+        size_t start = bytes.size();
+        uint8_t sum = 0;
+
+        bytes.push_back(0x55);
+        bytes.push_back(0xAA);
+        bytes.push_back((uint8_t) (values.size() * 3 + 1));
+        for (size_t i = 0; i < values.size(); i++) {
+            bytes.push_back((uint8_t) (i + 1));
+            bytes.push_back((uint8_t) (values[i] >> 8));
+            bytes.push_back((uint8_t) values[i]);
+        }
+        for (size_t i = start; i < bytes.size(); i++) {
+            sum = (uint8_t) (sum + bytes[i]);
+        }
+        bytes.push_back(sum);
+
+        Event event = Event();
+        event.kind = 1;
+        event.key = true;
+        event.values = values;
+        expected.push_back(event);
+        return start;
+    }
+
+    /*!
+     *  Append a format 2 frame of the next sample, return its offset.
+     *  Unless delivered, the frame is encoded but left out of the stream,
+     *  as if the receiver missed it.
+     */
+    size_t v2(const std::vector<uint16_t> &values, bool key,
+              bool delivered = true)
+    {
+        std::vector<uint8_t> frame;
+        const size_t maskBytes = (CHANNELS + 7) / 8;
+
+        frame.push_back(0xA5);
+        frame.push_back(0x5A);
+        frame.push_back((uint8_t) ((key ? 0x80 : 0) | sequence_));
+        frame.push_back((uint8_t) (sample_ >> 8));
+        frame.push_back((uint8_t) sample_);
+        frame.resize(frame.size() + maskBytes);
+        for (size_t i = 0; i < CHANNELS; i++) {
+            uint32_t value;
+            if (key) {
+                value = values[i];
+            } else if (values[i] != sent_[i]) {
+                int32_t delta = (int32_t) values[i] - (int32_t) sent_[i];
+                value = ((uint32_t) delta << 1) ^ (uint32_t) (delta >> 31);
+            } else {
+                continue;
+            }
+            frame[5 + i / 8] |= (uint8_t) (1 << (i % 8));
+            while (value >= 0x80) {
+                frame.push_back((uint8_t) (value | 0x80));
+                value >>= 7;
+            }
+            frame.push_back((uint8_t) value);
+        }
+        uint16_t crc = touchpro::crc16(&frame[2], frame.size() - 2);
+        frame.push_back((uint8_t) (crc >> 8));
+        frame.push_back((uint8_t) crc);
+
+        size_t start = bytes.size();
+        if (delivered) {
+            bytes.insert(bytes.end(), frame.begin(), frame.end());
+            Event event = Event();
+            event.kind = 2;
+            event.sequence = sequence_;
+            event.key = key;
+            event.sample = sample_;
+            event.values = values;
+            expected.push_back(event);
+        }
+        sent_ = values;
+        sequence_ = (uint8_t) ((sequence_ + 1) & 0x7F);
+        sample_++;
+        return start;
+    }
+
+    //! Append a tuning response, return its offset
+    size_t response(uint8_t operation, bool ok, uint8_t parameter,
+                    uint8_t index, uint16_t value)
+    {
+        size_t start = bytes.size();
+
+        bytes.resize(start + touchpro::TUNE_FRAME_SIZE);
+        touchpro::encodeCommand(&bytes[start],
+                                (uint8_t) (operation | (ok ? 0x80 : 0xC0)),
+                                parameter, index, value);
+
+        Event event = Event();
+        event.response.operation = operation;
+        event.response.ok = ok;
+        event.response.parameter = parameter;
+        event.response.index = index;
+        event.response.value = value;
+        expected.push_back(event);
+        return start;
+    }
+
+    //! Append bytes that are not part of a frame
+    void junk(const std::vector<uint8_t> &data)
+    {
+        bytes.insert(bytes.end(), data.begin(), data.end());
+    }
+
+    //! Corrupt the byte at offset of the last frame, which is then dropped
+    void corrupt(size_t offset)
+    {
+        bytes[offset] ^= 0x21;
+        expected.pop_back();
+    }
+
+    std::vector<uint8_t> bytes;
+    std::vector<Event> expected;
+
+private:
+    uint8_t sequence_;
+    uint16_t sample_;
+    std::vector<uint16_t> sent_;
+};
+
+//! Pseudo-terminal: bytes written to the master are read through Source
+class Loopback {
+public:
+    Loopback() : master_(-1) {}
+    ~Loopback() { if (master_ >= 0) close(master_); }
+
+    bool open()
+    {
+        master_ = posix_openpt(O_RDWR | O_NOCTTY);
+        if (master_ < 0 || grantpt(master_) != 0 || unlockpt(master_) != 0) {
+            std::perror("test_parser: posix_openpt");
+            return false;
+        }
+        const char *slave = ptsname(master_);
+        if (!slave || !source_.open(slave, 115200)) {
+            std::printf("test_parser: %s\n", source_.error().c_str());
+            return false;
+        }
+        return true;
+    }
+
+    //! Write size bytes to the master and push all of them to parser
+    bool transfer(const uint8_t *data, size_t size, touchpro::Parser &parser,
+                  Recorder &recorder)
+    {
+        uint8_t buffer[256];
+
+        while (size) {
+            size_t piece = size < 512 ? size : 512;  // within the tty buffer
+            for (size_t written = 0; written < piece; ) {
+                ssize_t n = write(master_, data + written, piece - written);
+                if (n <= 0) {
+                    std::perror("test_parser: write");
+                    return false;
+                }
+                written += (size_t) n;
+            }
+            for (size_t received = 0; received < piece; ) {
+                if (!source_.wait(1000)) {
+                    std::printf("test_parser: %zu of %zu bytes received\n",
+                                received, piece);
+                    return false;
+                }
+                long n = source_.read(buffer, sizeof(buffer));
+                if (n <= 0) {
+                    std::printf("test_parser: read: %s\n",
+                                source_.error().c_str());
+                    return false;
+                }
+                parser.push(buffer, (size_t) n, recorder);
+                received += (size_t) n;
+            }
+            data += piece;
+            size -= piece;
+        }
+        return true;
+    }
+
+private:
+    int master_;
+    touchpro::Source source_;
+};
+
+//! True if a sync word starts within data after its first byte
+bool syncInside(const std::vector<uint8_t> &data, size_t start, size_t end)
+{
+    for (size_t i = start + 1; i + 1 < end; i++) {
+        if ((data[i] == 0x55 && data[i + 1] == 0xAA)
+                || (data[i] == 0xA5 && (data[i + 1] == 0x5A
+                                        || data[i + 1] == 0xC3))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+ *  Deliver stream split at every offset and byte by byte, each time to a
+ *  new parser, and compare the events and counters with the expected ones
+ */
+void run(Loopback &loopback, const std::string &name, const Stream &stream,
+         const touchpro::ParserStats &stats)
+{
+    const std::vector<uint8_t> &bytes = stream.bytes;
+
+    for (size_t split = 0; split <= bytes.size(); split++) {
+        const bool single = split == bytes.size();
+        std::string test = name + (single ? std::string(", byte by byte")
+                                          : ", split at "
+                                            + std::to_string(split));
+        touchpro::Parser parser(CHANNELS);
+        Recorder recorder;
+        bool ok = true;
+
+        if (single) {
+            for (size_t i = 0; ok && i < bytes.size(); i++) {
+                ok = loopback.transfer(&bytes[i], 1, parser, recorder);
+            }
+        } else {
+            ok = loopback.transfer(&bytes[0], split, parser, recorder)
+                 && loopback.transfer(&bytes[split], bytes.size() - split,
+                                      parser, recorder);
+        }
+        if (!ok) {
+            failures++;
+            return;
+        }
+        const touchpro::ParserStats &got = parser.stats();
+        check(recorder.events == stream.expected, test, "decoded events");
+        check(got.frames == stats.frames, test, "frames");
+        check(got.checksumErrors == stats.checksumErrors, test,
+              "checksumErrors");
+        check(got.skippedBytes == stats.skippedBytes, test, "skippedBytes");
+        check(got.sequenceGaps == stats.sequenceGaps, test, "sequenceGaps");
+        if (failures) {
+            return;
+        }
+    }
+}
+
+touchpro::ParserStats counters(uint64_t frames, uint64_t checksumErrors,
+                               uint64_t skippedBytes, uint64_t sequenceGaps)
+{
+    touchpro::ParserStats stats;
+
+    stats.frames = frames;
+    stats.checksumErrors = checksumErrors;
+    stats.skippedBytes = skippedBytes;
+    stats.sequenceGaps = sequenceGaps;
+    return stats;
+}
+
+//! Channel values of sample n
+std::vector<uint16_t> values(unsigned n)
+{
+    std::vector<uint16_t> v(CHANNELS);
+
+    for (size_t i = 0; i < CHANNELS; i++) {
+        v[i] = (uint16_t) (3000 + 37 * i + ((n * (i + 3)) % 23));
+    }
+    if (n % 5 == 2) {
+        v[n % CHANNELS] = (uint16_t) (v[n % CHANNELS] - 700);   // a touch
+    }
+    return v;
+}
+
+} // namespace
+
+int main()
+{
+    Loopback loopback;
+
+    if (!loopback.open()) {
+        return 1;
+    }
+
+    // clean streams of each kind and all of them mixed with noise
+    {
+        Stream s;
+        for (unsigned n = 0; n < 4; n++) {
+            s.v1(values(n));
+        }
+        run(loopback, "format 1", s, counters(4, 0, 0, 0));
+    }
+    {
+        Stream s;
+        for (unsigned n = 0; n < 8; n++) {
+            s.v2(values(n), n % 4 == 0);
+        }
+        run(loopback, "format 2", s, counters(8, 0, 0, 0));
+    }
+    {
+        Stream s;
+        s.response(touchpro::TUNE_READ, true, touchpro::TUNE_THRESHOLD, 2, 80);
+        s.response(touchpro::TUNE_WRITE, true, touchpro::TUNE_MAX_RESPONSE, 0,
+                   1480);
+        s.response(touchpro::TUNE_READ, false, touchpro::TUNE_THRESHOLD, 9, 0);
+        run(loopback, "tuning responses", s, counters(0, 0, 0, 0));
+    }
+    {
+        Stream s;
+        s.junk(std::vector<uint8_t>{ 0x00, 0x55, 0x13, 0xA5 });
+        s.v2(values(0), true);
+        s.v1(values(1));
+        s.v2(values(2), false);
+        s.response(touchpro::TUNE_WRITE, true,
+                   touchpro::TUNE_RELEASE_THRESHOLD, 1, 60);
+        s.junk(std::vector<uint8_t>{ 0xA5, 0xFF });
+        s.v2(values(3), false);
+        run(loopback, "mixed", s, counters(4, 0, 6, 0));
+    }
+
+    // a corrupted checksum, CRC or response drops that frame only
+    {
+        Stream s;
+        s.v1(values(0));
+        size_t start = s.v1(values(1));
+        size_t end = s.bytes.size();
+        s.corrupt(end - 1);
+        s.v1(values(2));
+        check(!syncInside(s.bytes, start, end), "format 1 checksum",
+              "pick other values, the frame holds a sync word");
+        run(loopback, "format 1 checksum", s,
+            counters(2, 1, end - start, 0));
+    }
+    {
+        Stream s;
+        s.v1(values(0));
+        size_t start = s.v1(values(1));
+        size_t end = s.bytes.size();
+        s.corrupt(start + 4);
+        s.v1(values(2));   // a value byte
+        check(!syncInside(s.bytes, start, end), "format 1 value",
+              "pick other values, the frame holds a sync word");
+        run(loopback, "format 1 value", s, counters(2, 1, end - start, 0));
+    }
+    {
+        // the deltas after the lost frame refer to values not received:
+        // nothing is reported until the next key frame
+        Stream s;
+        s.v2(values(0), true);
+        s.v2(values(1), false);
+        size_t start = s.v2(values(2), false);
+        size_t end = s.bytes.size();
+        s.corrupt(end - 1);
+        s.v2(values(3), false);
+        s.expected.pop_back();
+        s.v2(values(4), true);
+        s.v2(values(5), false);
+        check(!syncInside(s.bytes, start, end), "format 2 CRC",
+              "pick other values, the frame holds a sync word");
+        run(loopback, "format 2 CRC", s, counters(4, 1, end - start, 1));
+    }
+    {
+        Stream s;
+        s.response(touchpro::TUNE_READ, true, touchpro::TUNE_THRESHOLD, 0, 80);
+        size_t start = s.response(touchpro::TUNE_READ, true,
+                                  touchpro::TUNE_THRESHOLD, 1, 50);
+        size_t end = s.bytes.size();
+        s.corrupt(end - 2);
+        s.v2(values(0), true);
+        check(!syncInside(s.bytes, start, end), "response CRC",
+              "pick other values, the frame holds a sync word");
+        run(loopback, "response CRC", s, counters(1, 1, end - start, 0));
+    }
+
+    // frames lost on the way: gaps counted, deltas wait for a key frame
+    {
+        Stream s;
+        s.v2(values(0), true);
+        s.v2(values(1), false);
+        s.v2(values(2), false, false);
+        s.v2(values(3), false, false);
+        s.v2(values(4), false);
+        s.expected.pop_back();
+        s.v2(values(5), true);
+        s.v2(values(6), false);
+        run(loopback, "sequence gap", s, counters(4, 0, 0, 2));
+    }
+    {
+        // the sequence number wraps from 127 to 0 without a gap
+        Stream s;
+        for (unsigned n = 0; n < 140; n++) {
+            s.v2(values(n), n % 32 == 0);
+        }
+        run(loopback, "sequence wrap", s, counters(140, 0, 0, 0));
+    }
+
+    if (failures) {
+        return 1;
+    }
+    std::printf("test_parser: pseudo-terminal loopback of format 1, format 2 "
+                "and tuning responses as expected\n");
+    return 0;
+}
@@ -0,0 +1,210 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   test_shm.cpp
+ *
+ *  @brief  Test of ShmWriter and ShmReader on a ring of a few slots.
+ *
+ *          Frames are read back copied and in place, a frame overwritten
+ *          while it is read in place is discarded, a reader that falls a
+ *          ring behind counts the frames lost, a writer refuses to reopen
+ *          the ring with another size, and a reader waiting in another
+ *          process is woken by the next frame published.
+ */
+#include "TouchProShm.h"
+
+#include <cstdio>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+int failures;
+
+void check(bool ok, const char *test, const char *what)
+{
+    if (!ok) {
+        std::printf("test_shm: %s: %s\n", test, what);
+        failures++;
+    }
+}
+
+//! Publish frame n with n + 1 channels of values n * 100 + channel
+void publish(touchpro::ShmWriter &writer, unsigned n)
+{
+    uint16_t values[touchpro::MAX_CHANNELS];
+    touchpro::Frame frame = touchpro::Frame();
+
+    frame.format = 2;
+    frame.sequence = (uint8_t) (n & 0x7F);
+    frame.key = n % 4 == 0;
+    frame.sample = (uint16_t) n;
+    frame.channels = n % 8 + 1;
+    for (size_t i = 0; i < frame.channels; i++) {
+        values[i] = (uint16_t) (n * 100 + i);
+    }
+    frame.values = values;
+    writer.publish(frame, 1000 + n);
+}
+
+bool matches(const touchpro::ShmSample &sample, unsigned n)
+{
+    if (sample.index != n || sample.time != 1000 + n || sample.format != 2
+            || sample.sequence != (n & 0x7F) || sample.key != (n % 4 == 0)
+            || sample.sample != n || sample.channels != n % 8 + 1) {
+        return false;
+    }
+    for (size_t i = 0; i < sample.channels; i++) {
+        if (sample.values[i] != n * 100 + i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "/touchpro_test_%d", (int) getpid());
+    const std::string name = buffer;
+    touchpro::ShmWriter writer;
+    touchpro::ShmSample sample;
+
+    if (!writer.open(name, 4)) {
+        std::printf("test_shm: %s\n", writer.error().c_str());
+        return 1;
+    }
+
+    // frames read back copied and in place
+    {
+        touchpro::ShmReader reader;
+        check(reader.open(name), "copy", reader.error().c_str());
+        check(!reader.next(sample), "copy", "frame before any was published");
+        for (unsigned n = 0; n < 3; n++) {
+            publish(writer, n);
+        }
+        for (unsigned n = 0; n < 2; n++) {
+            check(reader.next(sample) && matches(sample, n), "copy",
+                  "frame differs");
+        }
+        const touchpro::ShmFrame *frame = reader.peek();
+        check(frame && frame == reader.peek(), "peek", "no frame in place");
+        if (frame) {
+            frame->copy(sample);
+            check(matches(sample, 2) && frame->value(2) == 202, "peek",
+                  "frame differs");
+        }
+        check(reader.release(), "peek", "frame not valid");
+        check(!reader.peek() && !reader.release(), "peek",
+              "frame after the last one");
+        check(reader.lost() == 0, "copy", "frames lost");
+    }
+
+    // a frame overwritten while it is read in place is discarded
+    {
+        touchpro::ShmReader reader;
+        check(reader.open(name), "overwritten", reader.error().c_str());
+        publish(writer, 3);
+        const touchpro::ShmFrame *frame = reader.peek();
+        check(frame && frame->index() == 3, "overwritten", "no frame 3");
+        for (unsigned n = 4; n < 8; n++) {
+            publish(writer, n);
+        }
+        check(!reader.release(), "overwritten", "overwritten frame valid");
+        check(reader.next(sample) && matches(sample, 4), "overwritten",
+              "not continued with frame 4");
+        check(reader.lost() == 1, "overwritten", "lost frame not counted");
+    }
+
+    // a reader a ring behind continues with the oldest frame held
+    {
+        touchpro::ShmReader reader;
+        check(reader.open(name, true), "behind", reader.error().c_str());
+        for (unsigned n = 8; n < 14; n++) {
+            publish(writer, n);
+        }
+        for (unsigned n = 10; n < 14; n++) {
+            check(reader.next(sample) && matches(sample, n), "behind",
+                  "frame differs");
+        }
+        check(reader.lost() == 6, "behind", "lost frames not counted");
+    }
+
+    // the ring is reopened only with its size, continuing its sequence
+    {
+        touchpro::ShmWriter other;
+        check(!other.open(name, 8), "reopen", "ring resized");
+        check(other.open(name, 4), "reopen", other.error().c_str());
+        touchpro::ShmReader reader;
+        check(reader.open(name, true), "reopen", reader.error().c_str());
+        publish(other, 14);
+        for (unsigned n = 11; n < 15; n++) {
+            check(reader.next(sample) && matches(sample, n), "reopen",
+                  "sequence not continued");
+        }
+    }
+
+    // a reader waiting in another process is woken by the next frame
+    {
+        pid_t pid = fork();
+        if (pid == 0) {
+            touchpro::ShmReader reader;
+            if (!reader.open(name)) {
+                _exit(2);
+            }
+            uint64_t start = touchpro::hostTime();
+            bool woken = reader.wait(5000)
+                && touchpro::hostTime() - start < 1000000u
+                && reader.next(sample) && matches(sample, 15);
+            _exit(woken ? 0 : 1);
+        }
+        usleep(100000);
+        publish(writer, 15);
+        int status = 0;
+        waitpid(pid, &status, 0);
+        check(WIFEXITED(status) && WEXITSTATUS(status) == 0, "wait",
+              "waiting reader not woken");
+    }
+
+    writer.close();
+    shm_unlink(name.c_str());
+    if (failures) {
+        return 1;
+    }
+    std::printf("test_shm: ring frames copied, read in place, overwritten, "
+                "lost and waited for as expected\n");
+    return 0;
+}
@@ -0,0 +1,214 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   test_trace.cpp
+ *
+ *  @brief  Test of TraceReader on traces cut short and growing.
+ *
+ *          A trace of 10 records in blocks of 4 is written by TraceWriter
+ *          and read back cut at every length, where the index entry of the
+ *          last block may be missing or partly written, and while it grows
+ *          with refresh().  The records counted, their values and find()
+ *          for every time are checked against a search one by one.
+ */
+#include "TouchProTrace.h"
+
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+const uint32_t INTERVAL = 4;
+const unsigned RECORDS = 10;
+const size_t CHANNELS = 3;
+
+int failures;
+
+void check(bool ok, const std::string &test, const char *what)
+{
+    if (!ok) {
+        std::printf("test_trace: %s: %s\n", test.c_str(), what);
+        failures++;
+    }
+}
+
+uint64_t timeOf(unsigned n)
+{
+    return 1000 + 10 * n;
+}
+
+uint32_t valueOf(unsigned n, size_t field, size_t channel)
+{
+    return (uint32_t) (n * 100 + field * 10 + channel);
+}
+
+bool writeFile(const std::string &path, const std::vector<char> &bytes,
+               size_t size)
+{
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    bool ok = file && std::fwrite(bytes.data(), 1, size, file) == size;
+    return file && std::fclose(file) == 0 && ok;
+}
+
+bool readFile(const std::string &path, std::vector<char> &bytes)
+{
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    char buffer[4096];
+    size_t n;
+
+    if (!file) {
+        return false;
+    }
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + n);
+    }
+    std::fclose(file);
+    return true;
+}
+
+//! Records complete in the first size bytes of the trace
+uint64_t complete(const touchpro::TraceHeader &header, size_t size)
+{
+    uint64_t n = 0;
+    while (n < RECORDS && header.dataOffset + (n + 1) * header.recordSize
+            + (n / INTERVAL) * sizeof(touchpro::TraceIndex) <= size) {
+        n++;
+    }
+    return n;
+}
+
+void verify(const touchpro::TraceReader &reader, uint64_t records,
+            const std::string &test)
+{
+    check(reader.records() == records, test, "records miscounted");
+    if (reader.records() != records) {
+        return;
+    }
+    for (uint64_t i = 0; i < records; i++) {
+        const uint32_t *delta = reader.values(i, touchpro::TRACE_DELTA);
+        check(reader.record(i).time == timeOf((unsigned) i)
+              && reader.record(i).scan == i
+              && delta[CHANNELS - 1] == valueOf((unsigned) i, 1, CHANNELS - 1),
+              test, "record differs");
+    }
+    for (uint64_t time = timeOf(0) - 5; time <= timeOf(RECORDS) + 5;
+         time += 5) {
+        uint64_t expected = 0;
+        while (expected < records && timeOf((unsigned) expected) < time) {
+            expected++;
+        }
+        check(reader.find(time) == expected, test, "find() differs");
+    }
+}
+
+} // namespace
+
+int main()
+{
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "/tmp/test_trace_%d",
+                  (int) getpid());
+    const std::string path = buffer;
+    const std::string cut = path + ".cut";
+
+    std::vector<touchpro::TraceChannel> channels(CHANNELS,
+                                                 touchpro::TraceChannel());
+    touchpro::TraceWriter writer;
+    if (!writer.open(path, touchpro::TRACE_RAW | touchpro::TRACE_DELTA,
+                     channels, INTERVAL)) {
+        std::printf("test_trace: %s\n", writer.error().c_str());
+        return 1;
+    }
+    for (unsigned n = 0; n < RECORDS; n++) {
+        uint32_t values[2 * CHANNELS];
+        for (size_t i = 0; i < 2 * CHANNELS; i++) {
+            values[i] = valueOf(n, i / CHANNELS, i % CHANNELS);
+        }
+        writer.append(timeOf(n), n, 0, values);
+    }
+    std::vector<char> bytes;
+    if (!writer.close() || !readFile(path, bytes)) {
+        std::printf("test_trace: %s: not written\n", path.c_str());
+        return 1;
+    }
+    touchpro::TraceReader full;
+    if (!full.open(path)) {
+        std::printf("test_trace: %s\n", full.error().c_str());
+        return 1;
+    }
+    const touchpro::TraceHeader header = full.header();
+    verify(full, RECORDS, "complete");
+    full.close();
+
+    // cut at every length from the first record on
+    for (size_t size = header.dataOffset; size <= bytes.size(); size++) {
+        std::string test = "cut at " + std::to_string(size);
+        touchpro::TraceReader reader;
+        if (!writeFile(cut, bytes, size) || !reader.open(cut)) {
+            check(false, test, "not opened");
+            continue;
+        }
+        verify(reader, complete(header, size), test);
+    }
+
+    // growing while it is read, appended 20 bytes at a time
+    {
+        size_t size = header.dataOffset;
+        touchpro::TraceReader reader;
+        check(writeFile(cut, bytes, size) && reader.open(cut), "growing",
+              "not opened");
+        while (size < bytes.size()) {
+            size_t step = bytes.size() - size < 20 ? bytes.size() - size : 20;
+            std::FILE *file = std::fopen(cut.c_str(), "ab");
+            bool ok = file && std::fwrite(&bytes[size], 1, step, file) == step;
+            ok = file && std::fclose(file) == 0 && ok;
+            size += step;
+            std::string test = "grown to " + std::to_string(size);
+            if (!ok || !reader.refresh()) {
+                check(false, test, "not refreshed");
+                continue;
+            }
+            verify(reader, complete(header, size), test);
+        }
+    }
+
+    unlink(path.c_str());
+    unlink(cut.c_str());
+    if (failures) {
+        return 1;
+    }
+    std::printf("test_trace: traces cut at every length and growing read "
+                "and searched as expected\n");
+    return 0;
+}
@@ -0,0 +1,171 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   touchpro_bench.cpp
+ *
+ *  @brief  Parser throughput: frames per second for both frame formats,
+ *          pushed in chunks of a given size
+ *
+ *          touchpro_bench [frames] [chunk size] [channels]
+ */
+#include "TouchProParser.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+// Frames as sent by UART_sendTouchData()
+void encodeV1(std::vector<uint8_t> &out, const uint16_t *values,
+              size_t channels)
+{
+    size_t start = out.size();
+    uint8_t sum = 0;
+
+    out.push_back(0x55);
+    out.push_back(0xAA);
+    out.push_back((uint8_t) (channels * 3 + 1));
+    for (size_t i = 0; i < channels; i++) {
+        out.push_back((uint8_t) (i + 1));
+        out.push_back((uint8_t) (values[i] >> 8));
+        out.push_back((uint8_t) values[i]);
+    }
+    for (size_t i = start; i < out.size(); i++) {
+        sum = (uint8_t) (sum + out[i]);
+    }
+    out.push_back(sum);
+}
+
+// Frames as sent by UART_sendTouchDataV2()
+void encodeV2(std::vector<uint8_t> &out, const uint16_t *values,
+              const uint16_t *sent, size_t channels, uint8_t sequence,
+              uint16_t sample, bool key)
+{
+    const size_t maskBytes = (channels + 7) / 8;
+
+    out.push_back(0xA5);
+    out.push_back(0x5A);
+    size_t start = out.size();
+    out.push_back((uint8_t) ((key ? 0x80 : 0) | sequence));
+    out.push_back((uint8_t) (sample >> 8));
+    out.push_back((uint8_t) sample);
+    size_t mask = out.size();
+    out.resize(out.size() + maskBytes);
+    for (size_t i = 0; i < channels; i++) {
+        uint32_t value;
+        if (key) {
+            value = values[i];
+        } else if (values[i] != sent[i]) {
+            int32_t delta = (int32_t) values[i] - (int32_t) sent[i];
+            value = ((uint32_t) delta << 1) ^ (uint32_t) (delta >> 31);
+        } else {
+            continue;
+        }
+        out[mask + i / 8] |= (uint8_t) (1 << (i % 8));
+        while (value >= 0x80) {
+            out.push_back((uint8_t) (value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((uint8_t) value);
+    }
+    uint16_t crc = touchpro::crc16(&out[start], out.size() - start);
+    out.push_back((uint8_t) (crc >> 8));
+    out.push_back((uint8_t) crc);
+}
+
+class Counter : public touchpro::FrameHandler {
+public:
+    Counter() : frames(0), sum(0) {}
+
+    void frame(const touchpro::Frame &frame)
+    {
+        frames++;
+        sum += frame.values[frame.channels - 1];
+    }
+
+    size_t frames;
+    uint64_t sum;
+};
+
+void run(const char *name, const std::vector<uint8_t> &stream, size_t frames,
+         size_t chunk, size_t channels)
+{
+    touchpro::Parser parser(channels);
+    Counter counter;
+
+    std::chrono::steady_clock::time_point begin =
+        std::chrono::steady_clock::now();
+    for (size_t i = 0; i < stream.size(); i += chunk) {
+        size_t size = stream.size() - i < chunk ? stream.size() - i : chunk;
+        parser.push(&stream[i], size, counter);
+    }
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - begin).count();
+
+    std::printf("%s: %zu/%zu frames, %zu bytes, %.3f s, %.0f frames/s, "
+                "%.1f MB/s\n", name, counter.frames, frames, stream.size(),
+                seconds, counter.frames / seconds,
+                stream.size() / seconds / 1e6);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    size_t frames = argc > 1 ? std::strtoul(argv[1], 0, 10) : 1000000;
+    size_t chunk = argc > 2 ? std::strtoul(argv[2], 0, 10) : 4096;
+    size_t channels = argc > 3 ? std::strtoul(argv[3], 0, 10) : 4;
+    std::vector<uint8_t> v1, v2;
+    std::vector<uint16_t> values(channels, 3000), sent(channels);
+
+    if (!frames || !chunk || !channels || channels > touchpro::MAX_CHANNELS) {
+        std::fprintf(stderr, "usage: touchpro_bench [frames] [chunk size] "
+                     "[channels]\n");
+        return 2;
+    }
+    std::srand(1);
+    for (size_t f = 0; f < frames; f++) {
+        // counts wander by a few counts per scan like untouched elements
+        for (size_t i = 0; i < channels; i++) {
+            values[i] = (uint16_t) (values[i] + std::rand() % 7 - 3);
+        }
+        encodeV1(v1, &values[0], channels);
+        encodeV2(v2, &values[0], &sent[0], channels, (uint8_t) (f & 0x7F),
+                 (uint16_t) f, f % 64 == 0);
+        sent = values;
+    }
+    run("format 1", v1, frames, chunk, channels);
+    run("format 2", v2, frames, chunk, channels);
+    return 0;
+}
@@ -0,0 +1,162 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   touchpro_dump.cpp
+ *
+ *  @brief  Decode the TouchProTool_Demo_UART stream of a serial device or a
+ *          file and write the frames as CSV or binary records
+ */
+#include "TouchProParser.h"
+#include "TouchProSource.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+void usage()
+{
+    std::fprintf(stderr,
+        "usage: touchpro_dump [-b baud] [-n channels] [-f csv|bin] [-s] "
+        "device|file|-\n"
+        "  -b baud      baud rate of a serial device (default 9600)\n"
+        "  -n channels  SENSOR_NUM of the firmware, needed for FRAME_FORMAT 2\n"
+        "  -f csv       one line per frame: format,sequence,key,sample,values\n"
+        "  -f bin       per frame: format, sequence | key << 7 (1 byte each),\n"
+        "               sample (2 bytes), channel count (1 byte), values\n"
+        "               (2 bytes each), 2-byte fields little endian\n"
+        "  -s           print the parser counters to stderr at the end\n");
+}
+
+class Writer : public touchpro::FrameHandler {
+public:
+    explicit Writer(bool binary) : binary_(binary) {}
+
+    void frame(const touchpro::Frame &frame)
+    {
+        if (binary_) {
+            uint8_t record[5 + 2 * touchpro::MAX_CHANNELS];
+            size_t size = 0;
+            record[size++] = frame.format;
+            record[size++] = (uint8_t) (frame.sequence | (frame.key << 7));
+            record[size++] = (uint8_t) frame.sample;
+            record[size++] = (uint8_t) (frame.sample >> 8);
+            record[size++] = (uint8_t) frame.channels;
+            for (size_t i = 0; i < frame.channels; i++) {
+                record[size++] = (uint8_t) frame.values[i];
+                record[size++] = (uint8_t) (frame.values[i] >> 8);
+            }
+            std::fwrite(record, 1, size, stdout);
+            return;
+        }
+        std::printf("%u,%u,%u,%u", frame.format, frame.sequence,
+                    frame.key ? 1u : 0u, frame.sample);
+        for (size_t i = 0; i < frame.channels; i++) {
+            std::printf(",%u", frame.values[i]);
+        }
+        std::putchar('\n');
+    }
+
+private:
+    bool binary_;
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    unsigned long baud = 9600;
+    size_t channels = 0;
+    bool binary = false;
+    bool stats = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:n:f:s")) != -1) {
+        switch (opt) {
+        case 'b':
+            baud = std::strtoul(optarg, 0, 10);
+            break;
+        case 'n':
+            channels = std::strtoul(optarg, 0, 10);
+            break;
+        case 'f':
+            if (std::strcmp(optarg, "bin") == 0) {
+                binary = true;
+            } else if (std::strcmp(optarg, "csv") != 0) {
+                usage();
+                return 2;
+            }
+            break;
+        case 's':
+            stats = true;
+            break;
+        default:
+            usage();
+            return 2;
+        }
+    }
+    if (optind != argc - 1 || channels > touchpro::MAX_CHANNELS) {
+        usage();
+        return 2;
+    }
+
+    touchpro::Source source;
+    if (!source.open(argv[optind], baud)) {
+        std::fprintf(stderr, "touchpro_dump: %s\n", source.error().c_str());
+        return 1;
+    }
+
+    touchpro::Parser parser(channels);
+    Writer writer(binary);
+    uint8_t buffer[4096];
+    long n;
+    while ((n = source.read(buffer, sizeof(buffer))) > 0) {
+        parser.push(buffer, (size_t) n, writer);
+        std::fflush(stdout);
+    }
+    if (n < 0) {
+        std::fprintf(stderr, "touchpro_dump: %s\n", source.error().c_str());
+    }
+    if (stats) {
+        const touchpro::ParserStats &s = parser.stats();
+        std::fprintf(stderr, "frames %llu, checksum errors %llu, "
+                     "skipped bytes %llu, sequence gaps %llu\n",
+                     (unsigned long long) s.frames,
+                     (unsigned long long) s.checksumErrors,
+                     (unsigned long long) s.skippedBytes,
+                     (unsigned long long) s.sequenceGaps);
+    }
+    return n < 0 ? 1 : 0;
+}
@@ -0,0 +1,507 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   touchpro_ingest.cpp
+ *
+ *  @brief  Read the TouchProTool_Demo_UART streams of many boards at once
+ *
+ *  Every source (serial device, pseudo-terminal or file) is read
+ *  non-blocking.  The sources are divided among a few worker threads; each
+ *  waits for all of its sources with one epoll instance and parses each
+ *  chunk as it arrives.  Files cannot be waited for and are read whenever
+ *  the worker is not waiting.  Frames are written to standard output as CSV
+ *  lines tagged with the board ID and the host time at which the chunk
+ *  completing the frame was read.  Per-board throughput and error counters
+ *  are reported to standard error.
+ */
+#include "TouchProParser.h"
+#include "TouchProSource.h"
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/epoll.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t READ_SIZE = 4096;          // bytes read from a source at a time
+const size_t OUTPUT_FLUSH = 65536;      // bytes of CSV buffered per worker
+const int WAIT_TIMEOUT = 200;           // ms, to notice a stop request
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void usage()
+{
+    std::fprintf(stderr,
+        "usage: touchpro_ingest [-b baud] [-n channels] [-t threads] "
+        "[-i seconds] [-q]\n"
+        "                       [-l list] [ID=]device|file ...\n"
+        "  -b baud      baud rate of the serial devices (default 9600)\n"
+        "  -n channels  SENSOR_NUM of the firmware, needed for FRAME_FORMAT 2\n"
+        "  -t threads   worker threads (default 1)\n"
+        "  -i seconds   interval of the counter reports, 0 for a report at\n"
+        "               the end only (default 10)\n"
+        "  -q           count the frames without writing them\n"
+        "  -l list      read further sources from a file, one per line\n"
+        "  ID           board ID written with the frames (default: the\n"
+        "               position of the source, starting at 0)\n"
+        "Frames are written as CSV lines board,time,format,sequence,key,"
+        "sample,values;\n"
+        "time is the host time of reception in microseconds since the "
+        "epoch.\n");
+}
+
+void stop(int)
+{
+    stopRequested = 1;
+}
+
+uint64_t now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t) ts.tv_sec * 1000000u + (uint64_t) ts.tv_nsec / 1000u;
+}
+
+//! CSV lines of one worker, written to standard output in blocks
+class Output {
+public:
+    explicit Output(bool enabled) : enabled_(enabled) {}
+    ~Output() { flush(); }
+
+    bool enabled() const { return enabled_; }
+
+    std::string &buffer() { return buffer_; }
+
+    void flush()
+    {
+        if (buffer_.empty()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::fwrite(buffer_.data(), 1, buffer_.size(), stdout);
+        std::fflush(stdout);
+        buffer_.clear();
+    }
+
+private:
+    static std::mutex mutex_;
+    bool enabled_;
+    std::string buffer_;
+};
+
+std::mutex Output::mutex_;
+
+//! Counters of a board, read by the reporting thread
+struct Counters {
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> frames;
+    std::atomic<uint64_t> checksumErrors;
+    std::atomic<uint64_t> skippedBytes;
+    std::atomic<uint64_t> sequenceGaps;
+    std::atomic<bool> closed;
+
+    Counters() : bytes(0), frames(0), checksumErrors(0), skippedBytes(0),
+                 sequenceGaps(0), closed(false) {}
+};
+
+class Board : public touchpro::FrameHandler {
+public:
+    Board(const std::string &id, const std::string &path, size_t channels)
+        : id_(id), path_(path), parser_(channels), output_(0), time_(0),
+          pollable_(false) {}
+
+    const std::string &id() const { return id_; }
+    const std::string &path() const { return path_; }
+    touchpro::Source &source() { return source_; }
+    const Counters &counters() const { return counters_; }
+    bool pollable() const { return pollable_; }
+    void setPollable(bool pollable) { pollable_ = pollable; }
+    void setOutput(Output *output) { output_ = output; }
+
+    /*!
+     *  @brief  Read and parse the bytes available
+     *  @return false at end of file or on a read error
+     */
+    bool read()
+    {
+        uint8_t buffer[READ_SIZE];
+        long n = source_.read(buffer, sizeof(buffer));
+
+        if (n == touchpro::Source::WOULD_BLOCK) {
+            return true;
+        }
+        if (n <= 0) {
+            if (n < 0) {
+                std::fprintf(stderr, "touchpro_ingest: %s: %s\n",
+                             path_.c_str(), source_.error().c_str());
+            }
+            counters_.closed.store(true, std::memory_order_relaxed);
+            return false;
+        }
+        time_ = now();
+        parser_.push(buffer, (size_t) n, *this);
+
+        const touchpro::ParserStats &s = parser_.stats();
+        counters_.bytes.fetch_add((uint64_t) n, std::memory_order_relaxed);
+        counters_.frames.store(s.frames, std::memory_order_relaxed);
+        counters_.checksumErrors.store(s.checksumErrors,
+                                       std::memory_order_relaxed);
+        counters_.skippedBytes.store(s.skippedBytes,
+                                     std::memory_order_relaxed);
+        counters_.sequenceGaps.store(s.sequenceGaps,
+                                     std::memory_order_relaxed);
+        return true;
+    }
+
+    void frame(const touchpro::Frame &frame)
+    {
+        if (!output_->enabled()) {
+            return;
+        }
+        char field[32];
+        std::string &line = output_->buffer();
+        line += id_;
+        std::snprintf(field, sizeof(field), ",%llu,%u,%u,%u,%u",
+                      (unsigned long long) time_, frame.format,
+                      frame.sequence, frame.key ? 1u : 0u, frame.sample);
+        line += field;
+        for (size_t i = 0; i < frame.channels; i++) {
+            std::snprintf(field, sizeof(field), ",%u", frame.values[i]);
+            line += field;
+        }
+        line += '\n';
+        if (line.size() >= OUTPUT_FLUSH) {
+            output_->flush();
+        }
+    }
+
+private:
+    std::string id_;
+    std::string path_;
+    touchpro::Source source_;
+    touchpro::Parser parser_;
+    Output *output_;
+    uint64_t time_;                     // host time of the current chunk
+    bool pollable_;
+    Counters counters_;
+};
+
+//! A thread serving a share of the boards with one epoll instance
+class Worker {
+public:
+    explicit Worker(bool output) : epoll_(-1), output_(output), done_(false) {}
+
+    ~Worker()
+    {
+        if (epoll_ >= 0) {
+            close(epoll_);
+        }
+    }
+
+    void add(Board *board)
+    {
+        board->setOutput(&output_);
+        boards_.push_back(board);
+    }
+
+    bool done() const { return done_.load(); }
+
+    //! Register the boards with epoll; files are read without waiting
+    bool prepare()
+    {
+        epoll_ = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_ < 0) {
+            std::fprintf(stderr, "touchpro_ingest: epoll: %s\n",
+                         std::strerror(errno));
+            return false;
+        }
+        for (size_t i = 0; i < boards_.size(); i++) {
+            struct epoll_event event;
+            event.events = EPOLLIN;
+            event.data.ptr = boards_[i];
+            if (epoll_ctl(epoll_, EPOLL_CTL_ADD, boards_[i]->source().fd(),
+                          &event) == 0) {
+                boards_[i]->setPollable(true);
+            } else if (errno == EPERM) {
+                files_.push_back(boards_[i]);
+            } else {
+                std::fprintf(stderr, "touchpro_ingest: %s: %s\n",
+                             boards_[i]->path().c_str(),
+                             std::strerror(errno));
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void start() { thread_ = std::thread(&Worker::run, this); }
+
+    void join()
+    {
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+private:
+    void run()
+    {
+        struct epoll_event events[64];
+        size_t open = boards_.size();
+
+        while (open && !stopRequested) {
+            int n = epoll_wait(epoll_, events, 64,
+                               files_.empty() ? WAIT_TIMEOUT : 0);
+            for (int i = 0; i < n; i++) {
+                Board *board = static_cast<Board *>(events[i].data.ptr);
+                if (!board->read()) {
+                    epoll_ctl(epoll_, EPOLL_CTL_DEL, board->source().fd(), 0);
+                    board->source().close();
+                    open--;
+                }
+            }
+            for (size_t i = 0; i < files_.size(); ) {
+                if (files_[i]->read()) {
+                    i++;
+                    continue;
+                }
+                files_[i]->source().close();
+                files_.erase(files_.begin() + i);
+                open--;
+            }
+            output_.flush();
+        }
+        output_.flush();
+        done_.store(true);
+    }
+
+    std::vector<Board *> boards_;
+    std::vector<Board *> files_;        // sources epoll cannot wait for
+    int epoll_;
+    Output output_;
+    std::thread thread_;
+    std::atomic<bool> done_;
+};
+
+//! Counters at the previous report, for the rates
+struct Previous {
+    uint64_t bytes;
+    uint64_t frames;
+};
+
+void report(const std::vector<Board *> &boards,
+            std::vector<Previous> &previous, double seconds)
+{
+    std::fprintf(stderr, "%-12s %10s %10s %12s %10s %10s %10s %s\n",
+                 "board", "frames/s", "bytes/s", "frames", "checksum",
+                 "gaps", "skipped", "state");
+    for (size_t i = 0; i < boards.size(); i++) {
+        const Counters &c = boards[i]->counters();
+        uint64_t bytes = c.bytes.load(std::memory_order_relaxed);
+        uint64_t frames = c.frames.load(std::memory_order_relaxed);
+        std::fprintf(stderr, "%-12s %10.1f %10.1f %12llu %10llu %10llu "
+                     "%10llu %s\n",
+                     boards[i]->id().c_str(),
+                     seconds > 0 ? (frames - previous[i].frames) / seconds : 0,
+                     seconds > 0 ? (bytes - previous[i].bytes) / seconds : 0,
+                     (unsigned long long) frames,
+                     (unsigned long long)
+                         c.checksumErrors.load(std::memory_order_relaxed),
+                     (unsigned long long)
+                         c.sequenceGaps.load(std::memory_order_relaxed),
+                     (unsigned long long)
+                         c.skippedBytes.load(std::memory_order_relaxed),
+                     c.closed.load(std::memory_order_relaxed)
+                         ? "closed" : "open");
+        previous[i].bytes = bytes;
+        previous[i].frames = frames;
+    }
+}
+
+bool readList(const char *path, std::vector<std::string> &sources)
+{
+    std::ifstream list(path);
+    std::string line;
+
+    if (!list) {
+        std::fprintf(stderr, "touchpro_ingest: %s: %s\n", path,
+                     std::strerror(errno));
+        return false;
+    }
+    while (std::getline(list, line)) {
+        size_t first = line.find_first_not_of(" \t\r");
+        size_t last = line.find_last_not_of(" \t\r");
+        if (first != std::string::npos && line[first] != '#') {
+            sources.push_back(line.substr(first, last - first + 1));
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    unsigned long baud = 9600;
+    size_t channels = 0;
+    unsigned long threads = 1;
+    double interval = 10;
+    bool output = true;
+    std::vector<std::string> sources;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:n:t:i:ql:")) != -1) {
+        switch (opt) {
+        case 'b':
+            baud = std::strtoul(optarg, 0, 10);
+            break;
+        case 'n':
+            channels = std::strtoul(optarg, 0, 10);
+            break;
+        case 't':
+            threads = std::strtoul(optarg, 0, 10);
+            break;
+        case 'i':
+            interval = std::strtod(optarg, 0);
+            break;
+        case 'q':
+            output = false;
+            break;
+        case 'l':
+            if (!readList(optarg, sources)) {
+                return 1;
+            }
+            break;
+        default:
+            usage();
+            return 2;
+        }
+    }
+    for (int i = optind; i < argc; i++) {
+        sources.push_back(argv[i]);
+    }
+    if (sources.empty() || threads == 0 || interval < 0
+            || channels > touchpro::MAX_CHANNELS) {
+        usage();
+        return 2;
+    }
+
+    std::vector<Board *> boards;
+    for (size_t i = 0; i < sources.size(); i++) {
+        std::string id = std::to_string(i);
+        std::string path = sources[i];
+        size_t equals = path.find('=');
+        if (equals != std::string::npos) {
+            id = path.substr(0, equals);
+            path = path.substr(equals + 1);
+        }
+        Board *board = new Board(id, path, channels);
+        if (!board->source().open(path, baud)
+                || !board->source().setNonBlocking()) {
+            std::fprintf(stderr, "touchpro_ingest: %s\n",
+                         board->source().error().c_str());
+            delete board;
+            continue;
+        }
+        boards.push_back(board);
+    }
+    if (boards.empty()) {
+        return 1;
+    }
+
+    if (threads > boards.size()) {
+        threads = boards.size();
+    }
+    std::vector<Worker *> workers;
+    for (size_t i = 0; i < threads; i++) {
+        workers.push_back(new Worker(output));
+    }
+    for (size_t i = 0; i < boards.size(); i++) {
+        workers[i % threads]->add(boards[i]);
+    }
+    bool ready = true;
+    for (size_t i = 0; i < threads; i++) {
+        ready = workers[i]->prepare() && ready;
+    }
+
+    std::signal(SIGINT, stop);
+    std::signal(SIGTERM, stop);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::vector<Previous> previous(boards.size(), Previous());
+    uint64_t start = now();
+    uint64_t last = start;
+    if (ready) {
+        for (size_t i = 0; i < threads; i++) {
+            workers[i]->start();
+        }
+        for (;;) {
+            bool done = true;
+            for (size_t i = 0; i < threads; i++) {
+                done = done && workers[i]->done();
+            }
+            if (done) {
+                break;
+            }
+            usleep(100000);
+            uint64_t t = now();
+            if (interval > 0 && t - last >= interval * 1e6) {
+                report(boards, previous, (t - last) / 1e6);
+                last = t;
+            }
+        }
+        for (size_t i = 0; i < threads; i++) {
+            workers[i]->join();
+        }
+    }
+    previous.assign(boards.size(), Previous());
+    report(boards, previous, (now() - start) / 1e6);
+
+    for (size_t i = 0; i < threads; i++) {
+        delete workers[i];
+    }
+    for (size_t i = 0; i < boards.size(); i++) {
+        delete boards[i];
+    }
+    return ready ? 0 : 1;
+}
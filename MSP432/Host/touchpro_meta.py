@@ -0,0 +1,341 @@
+#!/usr/bin/env python3
+# --COPYRIGHT--,BSD
+# Copyright (c) 2016, Texas Instruments Incorporated
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# *  Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#
+# *  Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# *  Neither the name of Texas Instruments Incorporated nor the names of
+#    its contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+# THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+# OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+# WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+# OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+# --/COPYRIGHT--
+"""Write the trace channel list of a structure.c for touchpro_record
+
+One line per element of the selected sensors, in the order of the sensors
+and of their arrayPtr:
+
+    sensor element threshold maxResponse
+
+#ifdef, #ifndef, #if, #elif and #else sections are evaluated using the
+macros defined in the structure.h next to structure.c and those given with
+-D NAME or -D NAME=VALUE.  #if expressions may use defined(), !, &&, ||,
+comparisons, parentheses and integer values; the script stops with an error
+on anything else rather than guess which section is compiled.  Values that
+are not integer constant expressions are written as 0.
+
+    python touchpro_meta.py path/to/structure.c [-s sensor ...]
+                            [-D RO_CTIO_TA2_TA3 ...] [-o channels.txt]
+"""
+
+import argparse
+import os
+import re
+import sys
+
+
+def strip_comments(text):
+    return re.sub(r'//[^\n]*|/\*.*?\*/',
+                  lambda m: '\n' * m.group(0).count('\n') or ' ', text,
+                  flags=re.S)
+
+
+class ConditionError(Exception):
+    """An #if or #elif expression that cannot be evaluated."""
+
+
+def parse_number(text):
+    """Value of a C integer literal (decimal, octal or hex, any suffix)."""
+    m = re.match(r'^(0[xX][0-9a-fA-F]+|0[0-7]*|[1-9][0-9]*)[uUlL]*$', text)
+    if not m:
+        return None
+    digits = m.group(1)
+    if digits[:2] in ('0x', '0X'):
+        return int(digits, 16)
+    if digits.startswith('0'):
+        return int(digits, 8)
+    return int(digits)
+
+
+def evaluate(condition, defines):
+    """Evaluate an #if expression of defined(), !, &&, ||, comparisons,
+    parentheses, integer literals and macros with integer values.
+
+    Undefined macros are 0 as in C.  Anything else, such as a macro whose
+    value is not an integer literal, raises ConditionError.
+    """
+    tokens = []
+    for m in re.finditer(r'\s*(?:(&&|\|\||==|!=|<=|>=|[()!<>])'
+                         r'|(\w+)|(\S))', condition):
+        if m.group(3):
+            raise ConditionError('unsupported %r' % m.group(3))
+        tokens.append(m.group(1) or m.group(2))
+    position = [0]
+
+    def peek():
+        return tokens[position[0]] if position[0] < len(tokens) else None
+
+    def take(expected=None):
+        token = peek()
+        if token is None or (expected and token != expected):
+            raise ConditionError('expected %s' % (expected or 'operand'))
+        position[0] += 1
+        return token
+
+    def primary():
+        token = take()
+        if token == '(':
+            value = logical_or()
+            take(')')
+            return value
+        if token == '!':
+            return int(not primary())
+        if token == 'defined':
+            name = take()
+            if name == '(':
+                name = take()
+                take(')')
+            if not re.match(r'^[A-Za-z_]\w*$', name):
+                raise ConditionError('defined() of %r' % name)
+            return int(name in defines)
+        number = parse_number(token)
+        if number is not None:
+            return number
+        if not re.match(r'^[A-Za-z_]\w*$', token):
+            raise ConditionError('unexpected %r' % token)
+        if token not in defines:
+            return 0
+        value = parse_number(defines[token] or '')
+        if value is None:
+            raise ConditionError('value of %s unknown, give it with -D %s=...'
+                                 % (token, token))
+        return value
+
+    def comparison():
+        value = primary()
+        while peek() in ('==', '!=', '<', '>', '<=', '>='):
+            op, right = take(), primary()
+            value = int({'==': value == right, '!=': value != right,
+                         '<': value < right, '>': value > right,
+                         '<=': value <= right, '>=': value >= right}[op])
+        return value
+
+    def logical_and():
+        value = comparison()
+        while peek() == '&&':
+            take()
+            right = comparison()
+            value = int(bool(value) and bool(right))
+        return value
+
+    def logical_or():
+        value = logical_and()
+        while peek() == '||':
+            take()
+            right = logical_and()
+            value = int(bool(value) or bool(right))
+        return value
+
+    value = logical_or()
+    if peek() is not None:
+        raise ConditionError('unexpected %r' % peek())
+    return bool(value)
+
+
+def define_values(defines):
+    """Map NAME or NAME=VALUE strings to {NAME: VALUE or ''}."""
+    values = {}
+    for define in defines:
+        name, _, value = define.partition('=')
+        values[name.strip()] = value.strip()
+    return values
+
+
+def preprocess(text, defines):
+    """Keep the lines selected by #ifdef/#ifndef/#if/#elif/#else.
+
+    defines maps the defined macros to their values.  Conditions within
+    sections that are not kept are not evaluated.
+    """
+    def condition_value(directive, condition, line):
+        if directive in ('ifdef', 'ifndef'):
+            if not condition:
+                raise ConditionError('line %d: #%s without a name'
+                                     % (line, directive))
+            return (condition.split()[0] in defines) == (directive == 'ifdef')
+        try:
+            return evaluate(condition, defines)
+        except ConditionError as e:
+            raise ConditionError('line %d: #%s %s: %s'
+                                 % (line, directive, condition, e))
+
+    kept, stack = [], []    # stack of [active, taken] per conditional
+    for number, line in enumerate(text.split('\n'), 1):
+        m = re.match(r'\s*#\s*(ifdef|ifndef|if|elif|else|endif)\b(.*)', line)
+        if not m:
+            if all(active for active, taken in stack):
+                kept.append(line)
+            continue
+        directive, condition = m.group(1), m.group(2).strip()
+        outer = all(active for active, taken in stack[:-1])
+        if directive in ('ifdef', 'ifndef', 'if'):
+            if all(active for active, taken in stack):
+                value = condition_value(directive, condition, number)
+                stack.append([value, value])
+            else:
+                stack.append([False, True])
+        elif stack and directive == 'elif':
+            if outer and not stack[-1][1]:
+                value = condition_value('elif', condition, number)
+                stack[-1] = [value, value]
+            else:
+                stack[-1] = [False, True]
+        elif stack and directive == 'else':
+            stack[-1] = [outer and not stack[-1][1], True]
+        elif stack and directive == 'endif':
+            stack.pop()
+    return '\n'.join(kept)
+
+
+def configuration_defines(structure):
+    """Macros defined by the structure.h next to structure.c, as NAME or
+    NAME=VALUE."""
+    header = os.path.join(os.path.dirname(os.path.abspath(structure)),
+                          'structure.h')
+    if not os.path.exists(header):
+        return []
+    with open(header, encoding='latin-1') as f:
+        text = strip_comments(f.read())
+    return ['%s=%s' % (name, value.strip()) if value.strip() else name
+            for name, value in re.findall(r'^\s*#\s*define\s+(\w+)'
+                                          r'(?![\w(])([^\n]*)', text, re.M)]
+
+
+def split_top_level(text):
+    """Split an initializer list on commas that are not nested."""
+    items, depth, start = [], 0, 0
+    for i, c in enumerate(text):
+        if c in '([{':
+            depth += 1
+        elif c in ')]}':
+            depth -= 1
+        elif c == ',' and depth == 0:
+            items.append(text[start:i])
+            start = i + 1
+    items.append(text[start:])
+    return [item.strip() for item in items if item.strip()]
+
+
+def designators(body):
+    """Map designator (.name or .name[i]) to initializer expression."""
+    fields = {}
+    for item in split_top_level(body):
+        m = re.match(r'\.(\w+(?:\s*\[\s*\d+\s*\])?)\s*=\s*(.+)$', item, re.S)
+        if m:
+            fields[re.sub(r'\s', '', m.group(1))] = ' '.join(m.group(2).split())
+    return fields
+
+
+def element_name(expr):
+    m = re.match(r'&\s*(\w+)$', expr)
+    return m.group(1) if m else None
+
+
+def parse(text, defines=()):
+    """Elements and sensors of a structure.c.  defines are the macros for
+    the conditional sections, as NAME or NAME=VALUE."""
+    text = preprocess(strip_comments(text), define_values(defines))
+    elements = {}
+    for m in re.finditer(r'\bstruct\s+Element\s+(\w+)\s*=\s*\{(.*?)\}\s*;',
+                         text, re.S):
+        elements[m.group(1)] = designators(m.group(2))
+    arrays = {}
+    for m in re.finditer(r'\bstruct\s+Element\s+const\s*\*\s*const\s+(\w+)'
+                         r'\s*\[[^\]]*\]\s*=\s*\{(.*?)\}\s*;', text, re.S):
+        arrays[m.group(1)] = [element_name(e)
+                              for e in split_top_level(m.group(2))]
+    sensors = []
+    for m in re.finditer(r'\bstruct\s+Sensor\s+(\w+)\s*=\s*\{(.*?)\}\s*;',
+                         text, re.S):
+        name, fields = m.group(1), designators(m.group(2))
+        if 'arrayPtr' in fields:
+            members = arrays.get(fields['arrayPtr'])
+        else:
+            members, i = [], 0
+            while 'arrayPtr[%d]' % i in fields:
+                members.append(element_name(fields['arrayPtr[%d]' % i]))
+                i += 1
+        count = fields.get('numElements', '')
+        if members and count.isdigit() and int(count) <= len(members):
+            members = members[:int(count)]
+        sensors.append((name, fields, members))
+    return elements, sensors
+
+
+def constant(expr):
+    """Value of an integer constant expression such as 50+750, else 0."""
+    if not expr or not re.match(r'^[0-9xXa-fA-F+\-*/() ]+$', expr):
+        return 0
+    try:
+        return int(eval(re.sub(r'/', '//', expr), {'__builtins__': {}}))
+    except (SyntaxError, ZeroDivisionError, NameError):
+        return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('structure', help='structure.c of the application')
+    parser.add_argument('-s', '--sensor', action='append', default=[],
+                        help='sensor to include (default: all, in order)')
+    parser.add_argument('-D', dest='defines', action='append', default=[],
+                        metavar='NAME[=VALUE]',
+                        help='macro defined when selecting #if sections')
+    parser.add_argument('-o', '--output', help='output file (default stdout)')
+    args = parser.parse_args()
+    with open(args.structure, encoding='latin-1') as f:
+        try:
+            elements, sensors = parse(f.read(), configuration_defines(
+                args.structure) + args.defines)
+        except ConditionError as e:
+            sys.exit('%s: %s' % (args.structure, e))
+    byname = dict((name, members) for name, fields, members in sensors)
+    names = args.sensor or [name for name, fields, members in sensors]
+    lines = []
+    for name in names:
+        if byname.get(name) is None:
+            sys.exit('%s: sensor %s not found' % (args.structure, name))
+        for element in byname[name]:
+            fields = elements.get(element, {})
+            lines.append('%s %s %d %d' % (name, element,
+                                           constant(fields.get('threshold')),
+                                           constant(fields.get('maxResponse'))))
+    text = '\n'.join(lines) + '\n'
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == '__main__':
+    main()
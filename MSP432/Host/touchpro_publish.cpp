@@ -0,0 +1,134 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   touchpro_publish.cpp
+ *
+ *  @brief  Decode the TouchProTool_Demo_UART stream of one board and
+ *          publish the frames in shared memory for any number of local
+ *          readers, see TouchProShm.h and touchpro_watch
+ */
+#include "TouchProParser.h"
+#include "TouchProShm.h"
+#include "TouchProSource.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+void usage()
+{
+    std::fprintf(stderr,
+        "usage: touchpro_publish [-b baud] [-n channels] [-r slots] "
+        "device|file|- name\n"
+        "  -b baud      baud rate of a serial device (default 9600)\n"
+        "  -n channels  SENSOR_NUM of the firmware, needed for FRAME_FORMAT 2\n"
+        "  -r slots     frames held in the ring, a power of 2 (default 1024)\n"
+        "  name         shared memory object, e.g. /touchpro0\n");
+}
+
+class Publisher : public touchpro::FrameHandler {
+public:
+    explicit Publisher(touchpro::ShmWriter &writer)
+        : writer_(writer), time_(0) {}
+
+    void setTime(uint64_t time) { time_ = time; }
+
+    void frame(const touchpro::Frame &frame)
+    {
+        writer_.publish(frame, time_);
+    }
+
+private:
+    touchpro::ShmWriter &writer_;
+    uint64_t time_;                     // host time of the current chunk
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    unsigned long baud = 9600;
+    size_t channels = 0;
+    unsigned long slots = 1024;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:n:r:")) != -1) {
+        switch (opt) {
+        case 'b':
+            baud = std::strtoul(optarg, 0, 10);
+            break;
+        case 'n':
+            channels = std::strtoul(optarg, 0, 10);
+            break;
+        case 'r':
+            slots = std::strtoul(optarg, 0, 10);
+            break;
+        default:
+            usage();
+            return 2;
+        }
+    }
+    if (optind != argc - 2 || channels > touchpro::MAX_CHANNELS) {
+        usage();
+        return 2;
+    }
+
+    touchpro::Source source;
+    if (!source.open(argv[optind], baud)) {
+        std::fprintf(stderr, "touchpro_publish: %s\n",
+                     source.error().c_str());
+        return 1;
+    }
+    touchpro::ShmWriter writer;
+    if (!writer.open(argv[optind + 1], (uint32_t) slots)) {
+        std::fprintf(stderr, "touchpro_publish: %s\n",
+                     writer.error().c_str());
+        return 1;
+    }
+
+    touchpro::Parser parser(channels);
+    Publisher publisher(writer);
+    uint8_t buffer[4096];
+    long n;
+    while ((n = source.read(buffer, sizeof(buffer))) > 0) {
+        publisher.setTime(touchpro::hostTime());
+        parser.push(buffer, (size_t) n, publisher);
+    }
+    if (n < 0) {
+        std::fprintf(stderr, "touchpro_publish: %s\n",
+                     source.error().c_str());
+    }
+    return n < 0 ? 1 : 0;
+}
@@ -0,0 +1,238 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   touchpro_record.cpp
+ *
+ *  @brief  Record the delta counts sent by TouchProTool_Demo_UART in a
+ *          binary trace, see TouchProTrace.h
+ */
+#include "TouchProParser.h"
+#include "TouchProShm.h"
+#include "TouchProSource.h"
+#include "TouchProTrace.h"
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void usage()
+{
+    std::fprintf(stderr,
+        "usage: touchpro_record [-b baud] [-n channels] [-m channel list] "
+        "[-i interval]\n"
+        "                       device|file|- trace\n"
+        "  -b baud      baud rate of a serial device (default 9600)\n"
+        "  -n channels  SENSOR_NUM of the firmware, needed for FRAME_FORMAT 2\n"
+        "               without -m\n"
+        "  -m list      sensor, element, threshold and maxResponse of each\n"
+        "               channel, as written by touchpro_meta.py\n"
+        "  -i interval  records per index entry (default 1024)\n");
+}
+
+void stop(int)
+{
+    stopRequested = 1;
+}
+
+//! Install stop() without SA_RESTART, so that it interrupts a blocked read
+void catchSignal(int signal)
+{
+    struct sigaction action;
+
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = stop;
+    sigemptyset(&action.sa_mask);
+    sigaction(signal, &action, 0);
+}
+
+class Recorder : public touchpro::FrameHandler {
+public:
+    Recorder(touchpro::TraceWriter &writer, size_t channels)
+        : writer_(writer), channels_(channels), time_(0), scan_(0),
+          frames_(0), mismatched_(0), failed_(false) {}
+
+    void setTime(uint64_t time) { time_ = time; }
+    bool failed() const { return failed_; }
+    uint64_t frames() const { return frames_; }
+    uint64_t mismatched() const { return mismatched_; }
+
+    void frame(const touchpro::Frame &frame)
+    {
+        uint32_t values[touchpro::MAX_CHANNELS];
+
+        if (frame.channels != channels_) {
+            mismatched_++;
+            return;
+        }
+        // Scan number: the 16-bit sample number of format 2 unwrapped,
+        // the frame count for format 1
+        if (frame.format == 2 && frames_) {
+            scan_ += (uint16_t) (frame.sample - (uint16_t) scan_);
+        } else if (frame.format == 2) {
+            scan_ = frame.sample;
+        } else if (frames_) {
+            scan_++;
+        }
+        for (size_t i = 0; i < frame.channels; i++) {
+            values[i] = frame.values[i];
+        }
+        if (!failed_ && !writer_.append(time_, scan_,
+                                        frame.key ? touchpro::TRACE_KEY : 0,
+                                        values)) {
+            failed_ = true;
+        }
+        frames_++;
+    }
+
+private:
+    touchpro::TraceWriter &writer_;
+    size_t channels_;
+    uint64_t time_;                     // host time of the current chunk
+    uint32_t scan_;
+    uint64_t frames_;
+    uint64_t mismatched_;
+    bool failed_;
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    unsigned long baud = 9600;
+    size_t channels = 0;
+    unsigned long interval = 1024;
+    const char *list = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:n:m:i:")) != -1) {
+        switch (opt) {
+        case 'b':
+            baud = std::strtoul(optarg, 0, 10);
+            break;
+        case 'n':
+            channels = std::strtoul(optarg, 0, 10);
+            break;
+        case 'm':
+            list = optarg;
+            break;
+        case 'i':
+            interval = std::strtoul(optarg, 0, 10);
+            break;
+        default:
+            usage();
+            return 2;
+        }
+    }
+    if (optind != argc - 2 || channels > touchpro::MAX_CHANNELS
+            || (!list && !channels) || interval == 0) {
+        usage();
+        return 2;
+    }
+
+    std::vector<touchpro::TraceChannel> traceChannels;
+    if (list) {
+        std::string error;
+        if (!touchpro::readTraceChannels(list, traceChannels, error)) {
+            std::fprintf(stderr, "touchpro_record: %s\n", error.c_str());
+            return 1;
+        }
+        if (traceChannels.empty() || traceChannels.size() > touchpro::MAX_CHANNELS
+                || (channels && channels != traceChannels.size())) {
+            std::fprintf(stderr, "touchpro_record: %s: %u channels listed\n",
+                         list, (unsigned) traceChannels.size());
+            return 1;
+        }
+    } else {
+        for (size_t i = 0; i < channels; i++) {
+            touchpro::TraceChannel channel;
+            std::memset(&channel, 0, sizeof(channel));
+            std::snprintf(channel.element, sizeof(channel.element),
+                          "channel%u", (unsigned) i + 1);
+            traceChannels.push_back(channel);
+        }
+    }
+
+    touchpro::Source source;
+    if (!source.open(argv[optind], baud)) {
+        std::fprintf(stderr, "touchpro_record: %s\n", source.error().c_str());
+        return 1;
+    }
+    touchpro::TraceWriter writer;
+    if (!writer.open(argv[optind + 1], touchpro::TRACE_DELTA, traceChannels,
+                     (uint32_t) interval)) {
+        std::fprintf(stderr, "touchpro_record: %s\n", writer.error().c_str());
+        return 1;
+    }
+    catchSignal(SIGINT);
+    catchSignal(SIGTERM);
+    source.setInterruptible();
+
+    // Format 1 frames carry their channel count, format 2 needs it given
+    touchpro::Parser parser(channels ? channels : traceChannels.size());
+    Recorder recorder(writer, traceChannels.size());
+    uint8_t buffer[4096];
+    long n = 0;
+    while (!stopRequested && !recorder.failed()) {
+        n = source.read(buffer, sizeof(buffer));
+        if (n == touchpro::Source::INTERRUPTED) {
+            continue;                   // check stopRequested
+        }
+        if (n <= 0) {
+            break;
+        }
+        recorder.setTime(touchpro::hostTime());
+        parser.push(buffer, (size_t) n, recorder);
+    }
+    if (n < 0 && !stopRequested) {
+        std::fprintf(stderr, "touchpro_record: %s\n", source.error().c_str());
+    }
+    bool ok = !recorder.failed() && writer.close();
+    if (!ok) {
+        std::fprintf(stderr, "touchpro_record: %s: %s\n", argv[optind + 1],
+                     writer.error().c_str());
+    }
+    std::fprintf(stderr, "%llu records", (unsigned long long) recorder.frames());
+    if (recorder.mismatched()) {
+        std::fprintf(stderr, ", %llu frames with another channel count "
+                     "skipped", (unsigned long long) recorder.mismatched());
+    }
+    std::fputc('\n', stderr);
+    return ok && (n >= 0 || stopRequested) ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   touchpro_trace.cpp
+ *
+ *  @brief  Show the header of a binary trace, write records as CSV or find
+ *          the record at a time, see TouchProTrace.h
+ */
+#include "TouchProTrace.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const struct {
+    touchpro::TraceField field;
+    const char *name;
+} FIELDS[] = {
+    { touchpro::TRACE_RAW, "raw" },
+    { touchpro::TRACE_BASELINE, "baseline" },
+    { touchpro::TRACE_DELTA, "delta" },
+};
+
+void usage()
+{
+    std::fprintf(stderr,
+        "usage: touchpro_trace info trace\n"
+        "       touchpro_trace dump trace [FIRST [COUNT]]\n"
+        "       touchpro_trace find trace TIME\n"
+        "  info         fields, channels and records of the trace\n"
+        "  dump         records FIRST (default 0) to FIRST+COUNT-1 as CSV\n"
+        "               lines record,time,scan,key, then the values of each\n"
+        "               field present (raw, baseline, delta) for all channels\n"
+        "  find         first record at or after TIME, in microseconds since\n"
+        "               the epoch or, with a leading +, seconds since the start\n"
+        "               of the trace\n");
+}
+
+void info(const touchpro::TraceReader &trace)
+{
+    const touchpro::TraceHeader &h = trace.header();
+
+    std::printf("fields:");
+    for (size_t f = 0; f < sizeof(FIELDS) / sizeof(FIELDS[0]); f++) {
+        if (h.fields & FIELDS[f].field) {
+            std::printf(" %s", FIELDS[f].name);
+        }
+    }
+    std::printf("\nrecords: %llu of %u bytes, index every %u records\n",
+                (unsigned long long) trace.records(), h.recordSize,
+                h.indexInterval);
+    std::printf("start: %llu\n", (unsigned long long) h.startTime);
+    if (trace.records()) {
+        const touchpro::TraceRecord &first = trace.record(0);
+        const touchpro::TraceRecord &last = trace.record(trace.records() - 1);
+        std::printf("records from %llu to %llu (%.3f s), scans %u to %u\n",
+                    (unsigned long long) first.time,
+                    (unsigned long long) last.time,
+                    (last.time - first.time) / 1e6, first.scan, last.scan);
+    }
+    std::printf("channels: %u\n", (unsigned) trace.channels());
+    for (size_t i = 0; i < trace.channels(); i++) {
+        const touchpro::TraceChannel &c = trace.channel(i);
+        std::printf("  %2u %-24.24s %-24.24s threshold %u maxResponse %u\n",
+                    (unsigned) i, c.sensor[0] ? c.sensor : "-", c.element,
+                    c.threshold, c.maxResponse);
+    }
+}
+
+void dump(const touchpro::TraceReader &trace, uint64_t first, uint64_t count)
+{
+    uint64_t end = trace.records();
+
+    if (count && first + count < end) {
+        end = first + count;
+    }
+    for (uint64_t i = first; i < end; i++) {
+        const touchpro::TraceRecord &r = trace.record(i);
+        std::printf("%llu,%llu,%u,%u", (unsigned long long) i,
+                    (unsigned long long) r.time, r.scan,
+                    (r.flags & touchpro::TRACE_KEY) ? 1u : 0u);
+        for (size_t f = 0; f < sizeof(FIELDS) / sizeof(FIELDS[0]); f++) {
+            const uint32_t *values = trace.values(i, FIELDS[f].field);
+            for (size_t c = 0; values && c < trace.channels(); c++) {
+                std::printf(",%u", values[c]);
+            }
+        }
+        std::putchar('\n');
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        usage();
+        return 2;
+    }
+    touchpro::TraceReader trace;
+    if (!trace.open(argv[2])) {
+        std::fprintf(stderr, "touchpro_trace: %s\n", trace.error().c_str());
+        return 1;
+    }
+
+    if (std::strcmp(argv[1], "info") == 0 && argc == 3) {
+        info(trace);
+    } else if (std::strcmp(argv[1], "dump") == 0 && argc <= 5) {
+        dump(trace, argc > 3 ? std::strtoull(argv[3], 0, 10) : 0,
+             argc > 4 ? std::strtoull(argv[4], 0, 10) : 0);
+    } else if (std::strcmp(argv[1], "find") == 0 && argc == 4) {
+        uint64_t time;
+        if (argv[3][0] == '+') {
+            time = trace.header().startTime
+                + (uint64_t) (std::strtod(argv[3] + 1, 0) * 1e6);
+        } else {
+            time = std::strtoull(argv[3], 0, 10);
+        }
+        std::printf("%llu\n", (unsigned long long) trace.find(time));
+    } else {
+        usage();
+        return 2;
+    }
+    return 0;
+}
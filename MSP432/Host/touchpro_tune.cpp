@@ -0,0 +1,288 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   touchpro_tune.cpp
+ *
+ *  @brief  Read and write the tuning parameters of TouchProTool_Demo_UART
+ *          over its UART, and sweep a parameter while recording the counts
+ */
+#include "TouchProParser.h"
+#include "TouchProSource.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+const int ATTEMPTS = 5;
+const int RESPONSE_TIMEOUT = 500;       // ms per attempt
+
+const struct {
+    const char *name;
+    uint8_t parameter;
+} PARAMETERS[] = {
+    { "threshold", touchpro::TUNE_THRESHOLD },
+    { "maxresponse", touchpro::TUNE_MAX_RESPONSE },
+    { "release", touchpro::TUNE_RELEASE_THRESHOLD },
+    { "gate", touchpro::TUNE_ACCUMULATION_CYCLES },
+    { "tracking", touchpro::TUNE_TRACKING_RATE },
+};
+
+void usage()
+{
+    std::fprintf(stderr,
+        "usage: touchpro_tune [-b baud] [-n channels] device get PARAMETER "
+        "INDEX\n"
+        "       touchpro_tune [-b baud] [-n channels] device set PARAMETER "
+        "INDEX VALUE\n"
+        "       touchpro_tune [-b baud] [-n channels] device sweep PARAMETER "
+        "INDEX FIRST LAST STEP [FRAMES]\n"
+        "  PARAMETER    threshold, maxresponse, release (element INDEX),\n"
+        "               gate (accumulationCycles) or tracking (INDEX 0)\n"
+        "  sweep        sets each value from FIRST to LAST and writes the\n"
+        "               next FRAMES frames (default 50) as CSV lines\n"
+        "               value,format,sequence,key,sample,values; the value\n"
+        "               read before the sweep is restored afterwards\n");
+}
+
+bool parameterNumber(const char *name, uint8_t &parameter)
+{
+    for (size_t i = 0; i < sizeof(PARAMETERS) / sizeof(PARAMETERS[0]); i++) {
+        if (std::strcmp(name, PARAMETERS[i].name) == 0) {
+            parameter = PARAMETERS[i].parameter;
+            return true;
+        }
+    }
+    return false;
+}
+
+class Tuner : public touchpro::FrameHandler {
+public:
+    Tuner(touchpro::Source &source, size_t channels)
+        : source_(source), parser_(channels), collect_(0), value_(0),
+          answered_(false)
+    {
+    }
+
+    /*!
+     *  @brief  Send a command until its response arrives
+     *  @return false if there was no response or it reported an error
+     */
+    bool command(uint8_t operation, uint8_t parameter, uint8_t index,
+                 uint16_t value, uint16_t &result)
+    {
+        uint8_t frame[touchpro::TUNE_FRAME_SIZE];
+
+        touchpro::encodeCommand(frame, operation, parameter, index, value);
+        expected_.operation = operation;
+        expected_.parameter = parameter;
+        expected_.index = index;
+        for (int attempt = 0; attempt < ATTEMPTS; attempt++) {
+            answered_ = false;
+            if (!source_.write(frame, sizeof(frame))) {
+                return false;
+            }
+            std::chrono::steady_clock::time_point end =
+                std::chrono::steady_clock::now()
+                + std::chrono::milliseconds(RESPONSE_TIMEOUT);
+            while (!answered_) {
+                int left = (int) std::chrono::duration_cast<
+                    std::chrono::milliseconds>(
+                        end - std::chrono::steady_clock::now()).count();
+                if (left <= 0 || !receive(left)) {
+                    break;
+                }
+            }
+            if (answered_) {
+                result = answer_.value;
+                return answer_.ok;
+            }
+        }
+        return false;
+    }
+
+    //! Print the next frames CSV lines, prefixed with value
+    bool record(size_t frames, uint16_t value)
+    {
+        collect_ = frames;
+        value_ = value;
+        while (collect_) {
+            if (!receive(RESPONSE_TIMEOUT)) {
+                return false;
+            }
+        }
+        std::fflush(stdout);
+        return true;
+    }
+
+    void frame(const touchpro::Frame &frame)
+    {
+        if (!collect_) {
+            return;
+        }
+        std::printf("%u,%u,%u,%u,%u", value_, frame.format, frame.sequence,
+                    frame.key ? 1u : 0u, frame.sample);
+        for (size_t i = 0; i < frame.channels; i++) {
+            std::printf(",%u", frame.values[i]);
+        }
+        std::putchar('\n');
+        collect_--;
+    }
+
+    void response(const touchpro::Response &response)
+    {
+        if (response.operation == expected_.operation
+                && response.parameter == expected_.parameter
+                && response.index == expected_.index) {
+            answer_ = response;
+            answered_ = true;
+        }
+    }
+
+private:
+    bool receive(int timeout)
+    {
+        uint8_t buffer[256];
+
+        if (!source_.wait(timeout)) {
+            return false;
+        }
+        long n = source_.read(buffer, sizeof(buffer));
+        if (n <= 0) {
+            return false;
+        }
+        parser_.push(buffer, (size_t) n, *this);
+        return true;
+    }
+
+    touchpro::Source &source_;
+    touchpro::Parser parser_;
+    size_t collect_;
+    uint16_t value_;
+    touchpro::Response expected_;
+    touchpro::Response answer_;
+    bool answered_;
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    unsigned long baud = 9600;
+    size_t channels = 0;
+    uint8_t parameter;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:n:")) != -1) {
+        switch (opt) {
+        case 'b':
+            baud = std::strtoul(optarg, 0, 10);
+            break;
+        case 'n':
+            channels = std::strtoul(optarg, 0, 10);
+            break;
+        default:
+            usage();
+            return 2;
+        }
+    }
+    int args = argc - optind;
+    char **arg = argv + optind;
+    if (args < 4 || !parameterNumber(arg[2], parameter)
+            || channels > touchpro::MAX_CHANNELS) {
+        usage();
+        return 2;
+    }
+    std::string action = arg[1];
+    uint8_t index = (uint8_t) std::strtoul(arg[3], 0, 0);
+    if (!((action == "get" && args == 4) || (action == "set" && args == 5)
+            || (action == "sweep" && (args == 7 || args == 8)))) {
+        usage();
+        return 2;
+    }
+
+    touchpro::Source source;
+    if (!source.open(arg[0], baud, true)) {
+        std::fprintf(stderr, "touchpro_tune: %s\n", source.error().c_str());
+        return 1;
+    }
+    Tuner tuner(source, channels);
+    uint16_t value;
+
+    if (action == "get" || action == "set") {
+        bool ok = (action == "get")
+            ? tuner.command(touchpro::TUNE_READ, parameter, index, 0, value)
+            : tuner.command(touchpro::TUNE_WRITE, parameter, index,
+                            (uint16_t) std::strtoul(arg[4], 0, 0), value);
+        if (!ok) {
+            std::fprintf(stderr, "touchpro_tune: no valid response\n");
+            return 1;
+        }
+        std::printf("%u\n", value);
+        return 0;
+    }
+
+    long first = std::strtol(arg[4], 0, 0);
+    long last = std::strtol(arg[5], 0, 0);
+    long step = std::strtol(arg[6], 0, 0);
+    size_t frames = args == 8 ? std::strtoul(arg[7], 0, 10) : 50;
+    uint16_t original;
+    if (step == 0 || (last - first) / step < 0) {
+        usage();
+        return 2;
+    }
+    if (!tuner.command(touchpro::TUNE_READ, parameter, index, 0, original)) {
+        std::fprintf(stderr, "touchpro_tune: no valid response\n");
+        return 1;
+    }
+    int status = 0;
+    for (long v = first; step > 0 ? v <= last : v >= last; v += step) {
+        if (!tuner.command(touchpro::TUNE_WRITE, parameter, index,
+                           (uint16_t) v, value)
+                || !tuner.record(frames, value)) {
+            std::fprintf(stderr, "touchpro_tune: sweep stopped at %ld\n", v);
+            status = 1;
+            break;
+        }
+    }
+    if (!tuner.command(touchpro::TUNE_WRITE, parameter, index, original,
+                       value)) {
+        std::fprintf(stderr, "touchpro_tune: could not restore %u\n",
+                     original);
+        status = 1;
+    }
+    return status;
+}
@@ -0,0 +1,129 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+/*!
+ *  @file   touchpro_watch.cpp
+ *
+ *  @brief  Follow the frames published by touchpro_publish and write them
+ *          as CSV lines
+ */
+#include "TouchProShm.h"
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+namespace {
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void usage()
+{
+    std::fprintf(stderr,
+        "usage: touchpro_watch [-a] [-c count] [-s] name\n"
+        "  -a           start with the oldest frame held in the ring\n"
+        "  -c count     exit after count frames\n"
+        "  -s           print the frames lost to stderr at the end\n"
+        "Frames are written as CSV lines index,time,format,sequence,key,"
+        "sample,values;\n"
+        "time is the host time of reception in microseconds since the "
+        "epoch.\n");
+}
+
+void stop(int)
+{
+    stopRequested = 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    bool oldest = false;
+    bool stats = false;
+    unsigned long long count = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "ac:s")) != -1) {
+        switch (opt) {
+        case 'a':
+            oldest = true;
+            break;
+        case 'c':
+            count = std::strtoull(optarg, 0, 10);
+            break;
+        case 's':
+            stats = true;
+            break;
+        default:
+            usage();
+            return 2;
+        }
+    }
+    if (optind != argc - 1) {
+        usage();
+        return 2;
+    }
+
+    touchpro::ShmReader reader;
+    if (!reader.open(argv[optind], oldest)) {
+        std::fprintf(stderr, "touchpro_watch: %s\n", reader.error().c_str());
+        return 1;
+    }
+    std::signal(SIGINT, stop);
+    std::signal(SIGTERM, stop);
+
+    touchpro::ShmSample sample;
+    unsigned long long frames = 0;
+    while (!stopRequested && (count == 0 || frames < count)) {
+        if (!reader.next(sample)) {
+            std::fflush(stdout);
+            reader.wait(200);
+            continue;
+        }
+        std::printf("%llu,%llu,%u,%u,%u,%u",
+                    (unsigned long long) sample.index,
+                    (unsigned long long) sample.time, sample.format,
+                    sample.sequence, sample.key, sample.sample);
+        for (size_t i = 0; i < sample.channels; i++) {
+            std::printf(",%u", sample.values[i]);
+        }
+        std::putchar('\n');
+        frames++;
+    }
+    std::fflush(stdout);
+    if (stats) {
+        std::fprintf(stderr, "frames %llu, lost %llu\n", frames,
+                     (unsigned long long) reader.lost());
+    }
+    return 0;
+}
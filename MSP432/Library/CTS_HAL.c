@@ -61,6 +61,68 @@
 
 #include "CTS_HAL.h"
 
+#if defined(TIMERA2_NOVERFLOW) || defined(TIMERA3_NOVERFLOW)
+/*!
+ *  Upper 16 bits of the measurement in progress, incremented by the
+ *  measurement timer overflow ISR when EXTENDED_COUNTS is defined.
+ */
+static volatile uint16_t ctsOverflowCount;
+#endif
+
+/*
+ *  Gate (accumulationCycles) used for element i of a sensor.  With
+ *  ELEMENT_GATE a non-zero accumulationCycles in the element overrides the
+ *  setting of the sensor.
+ */
+#ifdef ELEMENT_GATE
+#define ACCUMULATION_CYCLES(group, i)                                         \
+    (((group)->arrayPtr[i])->accumulationCycles                               \
+        ? ((group)->arrayPtr[i])->accumulationCycles                          \
+        : (group)->accumulationCycles)
+#else
+#define ACCUMULATION_CYCLES(group, i)  ((group)->accumulationCycles)
+#endif
+
+#if defined(SMCLK_REFERENCE) && defined(RO_CTIO_TA2_TA3)
+/*!
+ *  ======== Smclk_Gate ========
+ *  @brief  Scale a gate counted on SMCLK to the active SMCLK frequency
+ *
+ *  \n      accumulationCycles of a gate sourced from SMCLK are given for an
+ *          SMCLK of SMCLK_REFERENCE Hz.  The cycles are scaled with the
+ *          frequency reported by TI_CTS_Get_SMCLK() so that the gate time,
+ *          and with it the counts, do not change with the clock setting.
+ *          Gates on other sources are not changed.
+ *
+ *  @param group  pointer to the sensor being measured
+ *  @param cycles accumulationCycles of the gate
+ *  @return gate in cycles of the gate source
+ */
+static uint16_t Smclk_Gate(const struct Sensor *group, uint16_t cycles)
+{
+    uint32_t scaled;
+
+    if(group->measGateSource != TIMER_SMCLK)
+    {
+        return cycles;
+    }
+    scaled = ((uint32_t)cycles * (TI_CTS_Get_SMCLK() / 1000))
+             / (SMCLK_REFERENCE / 1000);
+    if(scaled > 0xFFFF)
+    {
+        scaled = 0xFFFF;
+    }
+    else if(scaled == 0)
+    {
+        scaled = 1;
+    }
+    return (uint16_t)scaled;
+}
+#define GATE_CYCLES(group, cycles)  Smclk_Gate((group), (cycles))
+#else
+#define GATE_CYCLES(group, cycles)  (cycles)
+#endif
+
 #ifdef fRO_CTIO_TA2_TA3
 /*!
  *  ======== TI_CTS_fRO_CTIO_TA2_TA3_HAL ========
@@ -78,9 +140,9 @@
  *  @param counts pointer to where the measurements are to be written
  *  @return none
  */
-void TI_CTS_fRO_CTIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_fRO_CTIO_TA2_TA3_HAL(const struct Sensor *group,cts_count_t *counts)
 { 
-    uint8_t i;
+    uint16_t i;
     /*
      *  Allocate Context Save Variables
      *  TIMERA2: TA2CTL, TA2CCTL0, TA2CCR0
@@ -109,6 +171,10 @@ void TI_CTS_fRO_CTIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
      */
     TA3CTL = group->measGateSource + MC_2;
     TA3CCTL0 = CM_3+CCIS_2+CAP+SCS;
+#ifdef TIMERA3_NOVERFLOW
+    TA3CTL |= TAIE;                     // Count overflows in the high word
+    NVIC_EnableIRQ(TA3_N_IRQn);
+#endif
     /*
      *  TimerA2 is the gate (measurement interval) timer.  The number of
      *  oscillations counted, by TimerA3, within the gate interval represents
@@ -123,11 +189,17 @@ void TI_CTS_fRO_CTIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
 
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA2CCR0 = ACCUMULATION_CYCLES(group, i);
+#endif
     	/* Enable Capacitive Touch IO oscillation */
 	    *(group->inputCaptioctlRegister)
 	            = ((group->arrayPtr[i])->inputBits)+CAPTIOEN;
         TA3CTL |= TACLR;                   // Clear TimerA3, measurement timer
         TA3CTL &= ~TAIFG;                  // Clear overflow flag
+#ifdef TIMERA3_NOVERFLOW
+        ctsOverflowCount = 0;
+#endif
         TA2CTL |= (TACLR + MC_1);          // Clear and start TimerA2
 
         /*
@@ -141,6 +213,23 @@ void TI_CTS_fRO_CTIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
         __enable_interrupt();	// Enable interrupts
         __sleep();				// Go to low power mode 0
 
+#ifdef TIMERA3_NOVERFLOW
+        /*
+         *  The measurement timer keeps running after the capture.  A pending
+         *  overflow belongs to this measurement only if the captured value
+         *  has already wrapped.
+         */
+        __disable_interrupt();
+        TA3CCTL0 ^= CCIS0;  // Create SW capture of TA3R into TA3CCR0
+        TA2CTL &= ~MC_1;    // Halt Timer
+        if((TA3CTL & TAIFG) && (TA3CCR0 < 0x8000))
+        {
+            ctsOverflowCount++;
+        }
+        TA3CTL &= ~TAIFG;
+        counts[i] = ((uint32_t)ctsOverflowCount << 16) + TA3CCR0;
+        __enable_interrupt();
+#else
         TA3CCTL0 ^= CCIS0;  // Create SW capture of TA3R into TA3CCR0
         TA2CTL &= ~MC_1;    // Halt Timer
         if(TA3CTL & TAIFG)
@@ -156,6 +245,7 @@ void TI_CTS_fRO_CTIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
         {
             counts[i] = TA3CCR0;  // Save result
         }
+#endif
     } // End For Loop
 
     /* Context restore GIE within Status Register and registers used. */
@@ -189,9 +279,9 @@ void TI_CTS_fRO_CTIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param counts pointer to where the measurements are to be written
  *  @return        none
  */
-void TI_CTS_RO_CTIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
+void TI_CTS_RO_CTIO_TA2_TA3_HAL(const struct Sensor *group,cts_count_t *counts)
 {
-    uint8_t i;
+    uint16_t i;
     /*
      *  Allocate Context Save Variables
      *  TIMERA2: TA2CTL, TA2CCTL0, TA2CCR0
@@ -220,12 +310,16 @@ void TI_CTS_RO_CTIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
      */
     TA2CTL = TASSEL_3+MC_2;
     TA2CCTL0 = CM_3+CCIS_2+CAP+SCS;
+#ifdef TIMERA2_NOVERFLOW
+    TA2CTL |= TAIE;                     // Count overflows in the high word
+    NVIC_EnableIRQ(TA2_N_IRQn);
+#endif
     /*
      *  TimerA3 is the gate (measurement interval) timer.  The number of
      *  oscillations counted, by TimerA2, within the gate interval represents
      *  the measured capacitance.
      */
-    TA3CCR0 = (group->accumulationCycles);
+    TA3CCR0 = GATE_CYCLES(group, group->accumulationCycles);
     TA3CTL = group->measGateSource + group->sourceScale + TAIE;
     TA3CCTL0 = CCIE;
 
@@ -234,11 +328,17 @@ void TI_CTS_RO_CTIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
 
     for (i = 0; i<(group->numElements); i++)
     {
+#ifdef ELEMENT_GATE
+        TA3CCR0 = GATE_CYCLES(group, ACCUMULATION_CYCLES(group, i));
+#endif
     	/* Enable Capacitive Touch IO oscillation */
 	    *(group->inputCaptioctlRegister)
 	            = ((group->arrayPtr[i])->inputBits)+CAPTIOEN;
         TA2CTL |= TACLR;                   // Clear TimerA2, measurement timer
         TA2CTL &= ~TAIFG;                  // Clear overflow flag
+#ifdef TIMERA2_NOVERFLOW
+        ctsOverflowCount = 0;
+#endif
         TA3CTL |= (TACLR + MC_1);          // Clear and start TimerA3
         /*
 		 *  The measGateSource represents the gate source for timer TIMERA3,
@@ -251,6 +351,23 @@ void TI_CTS_RO_CTIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
         __enable_interrupt();  // Enable interrupts
         __sleep();			   // Go to low power mode 0
 
+#ifdef TIMERA2_NOVERFLOW
+        /*
+         *  The measurement timer keeps running after the capture.  A pending
+         *  overflow belongs to this measurement only if the captured value
+         *  has already wrapped.
+         */
+        __disable_interrupt();
+        TA2CCTL0 ^= CCIS0;  // Create SW capture of TA2R into TA2CCR0
+        TA3CTL &= ~MC_1;    // Halt Timer
+        if((TA2CTL & TAIFG) && (TA2CCR0 < 0x8000))
+        {
+            ctsOverflowCount++;
+        }
+        TA2CTL &= ~TAIFG;
+        counts[i] = ((uint32_t)ctsOverflowCount << 16) + TA2CCR0;
+        __enable_interrupt();
+#else
         TA2CCTL0 ^= CCIS0;  // Create SW capture of TA2R into TA2CCR0
         TA3CTL &= ~MC_1;    // Halt Timer
         if(TA2CTL & TAIFG)
@@ -266,6 +383,7 @@ void TI_CTS_RO_CTIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
         {
             counts[i] = TA2CCR0;  // Save result
         }
+#endif
     } // End For Loop
 
     /* Context restore registers that may have been modified. */
@@ -300,9 +418,9 @@ void TI_CTS_RO_CTIO_TA2_TA3_HAL(const struct Sensor *group,uint16_t *counts)
  *  @param counts pointer to where the measurements are to be written
  *  @return  none
  */
-void TI_CTS_RO_CTIO_TA2_WDTA_HAL(const struct Sensor *group, uint16_t *counts)
+void TI_CTS_RO_CTIO_TA2_WDTA_HAL(const struct Sensor *group, cts_count_t *counts)
 {
-    uint8_t i;
+    uint16_t i;
     /*
      *  Allocate Context Save Variables
      *  WDT: WDTCTL
@@ -332,6 +450,10 @@ void TI_CTS_RO_CTIO_TA2_WDTA_HAL(const struct Sensor *group, uint16_t *counts)
      */
     TA2CTL = TASSEL_3+MC_2;
     TA2CCTL0 = CM_3+CCIS_2+CAP+SCS;
+#ifdef TIMERA2_NOVERFLOW
+    TA2CTL |= TAIE;                     // Count overflows in the high word
+    NVIC_EnableIRQ(TA2_N_IRQn);
+#endif
 
     /*
      *  The WDTA is the gate (measurement interval) timer.  The number of
@@ -349,13 +471,16 @@ void TI_CTS_RO_CTIO_TA2_WDTA_HAL(const struct Sensor *group, uint16_t *counts)
 	            = ((group->arrayPtr[i])->inputBits)+CAPTIOEN;
 	    TA2CTL |= TACLR;        // Clear Timer_A2 measurement timer
 	    TA2CTL &= ~TAIFG;       // Clear the overflow flag
+#ifdef TIMERA2_NOVERFLOW
+	    ctsOverflowCount = 0;
+#endif
         /*
          *  The measGateSource represents the gate source for the WDTA, which
          *  can be sourced from ACLK, SMCLK, VLOCLK or X_CLK. The
          *  accumulationCycles represents the watchdog timer interval select.
          */
         WDTCTL = WDTPW+WDTTMSEL+WDTCNTCL+ group->measGateSource
-                + group->accumulationCycles;
+                + ACCUMULATION_CYCLES(group, i);
         /*
          *  The interrupt handler is defined in WDT_VECTOR, which simply clears
          *  the low power mode bits in the Status Register before returning
@@ -365,6 +490,23 @@ void TI_CTS_RO_CTIO_TA2_WDTA_HAL(const struct Sensor *group, uint16_t *counts)
         __enable_interrupt();  // Enable interrupts
         __sleep();             // Go to low power mode 0
 
+#ifdef TIMERA2_NOVERFLOW
+        /*
+         *  The measurement timer keeps running after the capture.  A pending
+         *  overflow belongs to this measurement only if the captured value
+         *  has already wrapped.
+         */
+        __disable_interrupt();
+        TA2CCTL0 ^= CCIS0;  // Create SW capture of TA2R into TA2CCR0
+        WDTCTL = WDTPW + WDTHOLD;  // Halt watchdog timer
+        if((TA2CTL & TAIFG) && (TA2CCR0 < 0x8000))
+        {
+            ctsOverflowCount++;
+        }
+        TA2CTL &= ~TAIFG;
+        counts[i] = ((uint32_t)ctsOverflowCount << 16) + TA2CCR0;
+        __enable_interrupt();
+#else
 	    TA2CCTL0 ^= CCIS0;  // Create SW capture of TA2R into TA2CCR0
 	    WDTCTL = WDTPW + WDTHOLD;  // Halt watchdog timer
         if(TA2CTL & TAIFG)
@@ -380,6 +522,7 @@ void TI_CTS_RO_CTIO_TA2_WDTA_HAL(const struct Sensor *group, uint16_t *counts)
         {
             counts[i] = TA2CCR0;  // Save result
         }
+#endif
     }  // End For Loop
 
     /* Context restore registers that were modified. */
@@ -455,3 +598,47 @@ void TA3_0_IRQHandler(void)
 	__low_power_mode_off_on_exit();
 }
 #endif
+
+#ifdef TIMERA2_NOVERFLOW
+/*!
+ *  ======== TIMER2_AN_ISR ========
+ *  @ingroup ISR_GROUP
+ *  @brief  TIMER2_AN_ISR
+ *
+ *          This ISR extends the measurement count of TimerA2 by counting
+ *          overflows in ctsOverflowCount (EXTENDED_COUNTS).
+ *
+ *  @param none
+ *  @return none
+ */
+void TA2_N_IRQHandler(void)
+{
+	if(TA2CTL & TAIFG)
+	{
+		TA2CTL &= ~TAIFG;
+		ctsOverflowCount++;
+	}
+}
+#endif
+
+#ifdef TIMERA3_NOVERFLOW
+/*!
+ *  ======== TIMER3_AN_ISR ========
+ *  @ingroup ISR_GROUP
+ *  @brief  TIMER3_AN_ISR
+ *
+ *          This ISR extends the measurement count of TimerA3 by counting
+ *          overflows in ctsOverflowCount (EXTENDED_COUNTS).
+ *
+ *  @param none
+ *  @return none
+ */
+void TA3_N_IRQHandler(void)
+{
+	if(TA3CTL & TAIFG)
+	{
+		TA3CTL &= ~TAIFG;
+		ctsOverflowCount++;
+	}
+}
+#endif